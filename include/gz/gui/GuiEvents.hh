@@ -18,6 +18,7 @@
 #define GZ_GUI_GUIEVENTS_HH_
 
 #include <QEvent>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -25,6 +26,7 @@
 
 #include <gz/common/KeyEvent.hh>
 #include <gz/common/MouseEvent.hh>
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/msgs/world_control.pb.h>
@@ -481,6 +483,88 @@ namespace gz::gui::events
         /// \brief Private data pointer
         GZ_UTILS_IMPL_PTR(dataPtr)
       };
+
+      /// \brief Event which is sent to find scene entities by position,
+      /// without walking the whole scene. Scene managers which keep a
+      /// spatial index, such as TransportSceneManager with
+      /// `<spatial_index>` enabled, add the entities they know of. It's
+      /// answered right away, so send it to the main window with
+      /// `QCoreApplication::sendEvent` and read the results afterwards.
+      class GZ_GUI_VISIBLE SpatialQuery : public QEvent
+      {
+        /// \brief Shape entities are looked up with
+        public: enum class Shape
+        {
+          /// \brief Entities whose bounds intersect a box
+          kBox,
+
+          /// \brief Entities whose bounds are within a distance of a point
+          kRadius,
+
+          /// \brief Entities whose bounds are hit by a ray
+          kRay
+        };
+
+        /// \brief Constructor for a box query
+        /// \param[in] _box Box.
+        public: explicit SpatialQuery(const math::AxisAlignedBox &_box);
+
+        /// \brief Constructor for a radius query
+        /// \param[in] _center Point.
+        /// \param[in] _radius Distance from the point.
+        public: SpatialQuery(const math::Vector3d &_center, double _radius);
+
+        /// \brief Constructor for a ray query
+        /// \param[in] _origin Ray origin.
+        /// \param[in] _direction Ray direction, doesn't need to be
+        /// normalized.
+        /// \param[in] _maxDistance Length of the ray.
+        public: SpatialQuery(const math::Vector3d &_origin,
+                             const math::Vector3d &_direction,
+                             double _maxDistance);
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 21);
+
+        /// \brief Get the shape of the query
+        /// \return Shape
+        public: Shape QueryShape() const;
+
+        /// \brief Get the box of a box query
+        /// \return Box
+        public: const math::AxisAlignedBox &Box() const;
+
+        /// \brief Get the center of a radius query, or the origin of a ray
+        /// query
+        /// \return Point
+        public: const math::Vector3d &Point() const;
+
+        /// \brief Get the direction of a ray query
+        /// \return Direction
+        public: const math::Vector3d &Direction() const;
+
+        /// \brief Get the radius of a radius query, or the length of a ray
+        /// query
+        /// \return Distance
+        public: double Distance() const;
+
+        /// \brief Add a matching entity. Called by scene managers.
+        /// \param[in] _id Entity id
+        /// \param[in] _distance Distance along the ray to the entity bounds
+        /// for ray queries, zero otherwise
+        public: void AddResult(std::uint64_t _id, double _distance = 0.0);
+
+        /// \brief Get the matching entities in the order they were added,
+        /// with their distance along the ray for ray queries. Each scene
+        /// manager adds ray results nearest first.
+        /// \return Entity ids and distances
+        public: const std::vector<std::pair<std::uint64_t, double>> &
+            Results() const;
+
+        /// \internal
+        /// \brief Private data pointer
+        GZ_UTILS_IMPL_PTR(dataPtr)
+      };
 }  // namespace gz::gui::events
 
 #endif  // GZ_GUI_GUIEVENTS_HH_
@@ -148,6 +148,27 @@ class PreRender::Implementation
 {
 };
 
+class SpatialQuery::Implementation
+{
+  /// \brief Shape of the query
+  public: SpatialQuery::Shape shape{SpatialQuery::Shape::kBox};
+
+  /// \brief Box of a box query
+  public: math::AxisAlignedBox box;
+
+  /// \brief Center of a radius query, or origin of a ray query
+  public: math::Vector3d point;
+
+  /// \brief Direction of a ray query
+  public: math::Vector3d direction;
+
+  /// \brief Radius of a radius query, or length of a ray query
+  public: double distance{0.0};
+
+  /// \brief Matching entities with their distance along the ray
+  public: std::vector<std::pair<std::uint64_t, double>> results;
+};
+
 /////////////////////////////////////////////////
 SnapIntervals::SnapIntervals(
             const math::Vector3d &_xyz,
@@ -428,4 +449,75 @@ PreRender::PreRender()
   : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
 {
 }
+
+/////////////////////////////////////////////////
+SpatialQuery::SpatialQuery(const math::AxisAlignedBox &_box)
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->shape = Shape::kBox;
+  this->dataPtr->box = _box;
+}
+
+/////////////////////////////////////////////////
+SpatialQuery::SpatialQuery(const math::Vector3d &_center, double _radius)
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->shape = Shape::kRadius;
+  this->dataPtr->point = _center;
+  this->dataPtr->distance = _radius;
+}
+
+/////////////////////////////////////////////////
+SpatialQuery::SpatialQuery(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, double _maxDistance)
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->shape = Shape::kRay;
+  this->dataPtr->point = _origin;
+  this->dataPtr->direction = _direction;
+  this->dataPtr->distance = _maxDistance;
+}
+
+/////////////////////////////////////////////////
+SpatialQuery::Shape SpatialQuery::QueryShape() const
+{
+  return this->dataPtr->shape;
+}
+
+/////////////////////////////////////////////////
+const math::AxisAlignedBox &SpatialQuery::Box() const
+{
+  return this->dataPtr->box;
+}
+
+/////////////////////////////////////////////////
+const math::Vector3d &SpatialQuery::Point() const
+{
+  return this->dataPtr->point;
+}
+
+/////////////////////////////////////////////////
+const math::Vector3d &SpatialQuery::Direction() const
+{
+  return this->dataPtr->direction;
+}
+
+/////////////////////////////////////////////////
+double SpatialQuery::Distance() const
+{
+  return this->dataPtr->distance;
+}
+
+/////////////////////////////////////////////////
+void SpatialQuery::AddResult(std::uint64_t _id, double _distance)
+{
+  this->dataPtr->results.emplace_back(_id, _distance);
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::pair<std::uint64_t, double>> &
+    SpatialQuery::Results() const
+{
+  return this->dataPtr->results;
+}
 }  // namespace gz::gui::events
@@ -291,3 +291,31 @@ TEST(GuiEventsTest, PreRender)
 
   EXPECT_LT(QEvent::User, event.type());
 }
+
+/////////////////////////////////////////////////
+TEST(GuiEventsTest, SpatialQuery)
+{
+  events::SpatialQuery boxQuery(math::AxisAlignedBox(0, 0, 0, 1, 2, 3));
+  EXPECT_LT(QEvent::User, boxQuery.type());
+  EXPECT_EQ(events::SpatialQuery::Shape::kBox, boxQuery.QueryShape());
+  EXPECT_EQ(math::AxisAlignedBox(0, 0, 0, 1, 2, 3), boxQuery.Box());
+  EXPECT_TRUE(boxQuery.Results().empty());
+
+  events::SpatialQuery radiusQuery(math::Vector3d(1, 2, 3), 4.0);
+  EXPECT_EQ(events::SpatialQuery::Shape::kRadius, radiusQuery.QueryShape());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), radiusQuery.Point());
+  EXPECT_DOUBLE_EQ(4.0, radiusQuery.Distance());
+
+  events::SpatialQuery rayQuery(math::Vector3d(1, 2, 3),
+      math::Vector3d(0, 0, -1), 10.0);
+  EXPECT_EQ(events::SpatialQuery::Shape::kRay, rayQuery.QueryShape());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), rayQuery.Point());
+  EXPECT_EQ(math::Vector3d(0, 0, -1), rayQuery.Direction());
+  EXPECT_DOUBLE_EQ(10.0, rayQuery.Distance());
+
+  rayQuery.AddResult(5u, 2.0);
+  rayQuery.AddResult(7u, 3.0);
+  ASSERT_EQ(2u, rayQuery.Results().size());
+  EXPECT_EQ(5u, rayQuery.Results()[0].first);
+  EXPECT_DOUBLE_EQ(3.0, rayQuery.Results()[1].second);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_EXPIRYQUEUE_HH_
+#define GZ_GUI_PLUGINS_EXPIRYQUEUE_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gz::gui::plugins
+{
+  /// \brief Namespace and id of a marker.
+  using MarkerKey = std::pair<std::string, std::uint64_t>;
+
+  /// \brief Markers ordered by the time their lifetime ends, so expired
+  /// markers are found without visiting the ones which haven't expired.
+  ///
+  /// The queue is a min-heap on the expiry time. Changing or removing a
+  /// marker's expiry leaves its old heap entry behind, which is skipped
+  /// when popped, and the heap is rebuilt once stale entries outnumber live
+  /// ones, so all operations take logarithmic amortized time.
+  class ExpiryQueue
+  {
+    /// \brief Time type, same as the marker lifetimes.
+    public: using Duration = std::chrono::steady_clock::duration;
+
+    /// \brief Set when a marker expires, replacing its previous expiry.
+    /// \param[in] _key Marker.
+    /// \param[in] _expiry Time the marker expires at. Zero means the marker
+    /// never expires.
+    public: void Set(const MarkerKey &_key, Duration _expiry)
+    {
+      if (_expiry.count() == 0)
+      {
+        this->Erase(_key);
+        return;
+      }
+
+      auto [it, inserted] = this->expiries.insert_or_assign(_key, _expiry);
+      if (!inserted)
+        ++this->stale;
+      this->heap.push_back({_expiry, it->first});
+      std::push_heap(this->heap.begin(), this->heap.end(), Later());
+      this->Compact();
+    }
+
+    /// \brief Stop tracking a marker.
+    /// \param[in] _key Marker.
+    /// \return True if the marker had an expiry.
+    public: bool Erase(const MarkerKey &_key)
+    {
+      if (this->expiries.erase(_key) == 0u)
+        return false;
+
+      ++this->stale;
+      this->Compact();
+      return true;
+    }
+
+    /// \brief Stop tracking all markers in a namespace.
+    /// \param[in] _ns Namespace.
+    public: void EraseNamespace(const std::string &_ns)
+    {
+      auto it = this->expiries.lower_bound({_ns, 0u});
+      while (it != this->expiries.end() && it->first.first == _ns)
+      {
+        it = this->expiries.erase(it);
+        ++this->stale;
+      }
+      this->Compact();
+    }
+
+    /// \brief Stop tracking all markers.
+    public: void Clear()
+    {
+      this->heap.clear();
+      this->expiries.clear();
+      this->stale = 0u;
+    }
+
+    /// \brief Remove the markers which expire at or before a time, earliest
+    /// first.
+    /// \param[in] _now Current time. Use Duration::max() to remove all
+    /// markers.
+    /// \param[in] _onExpired Callback invoked as
+    /// `void(const MarkerKey &_key)` for each expired marker. It may not
+    /// modify the queue.
+    /// \return Number of expired markers.
+    public: template <typename Fn>
+            std::size_t PopExpired(Duration _now, Fn &&_onExpired)
+    {
+      std::size_t count{0u};
+      while (!this->heap.empty() && this->heap.front().expiry <= _now)
+      {
+        std::pop_heap(this->heap.begin(), this->heap.end(), Later());
+        const Entry entry = this->heap.back();
+        this->heap.pop_back();
+
+        auto it = this->expiries.find(entry.key);
+        if (it == this->expiries.end() || it->second != entry.expiry)
+        {
+          --this->stale;
+          continue;
+        }
+
+        _onExpired(it->first);
+        this->expiries.erase(it);
+        ++count;
+      }
+      return count;
+    }
+
+    /// \brief Number of markers with an expiry.
+    /// \return Number of markers.
+    public: std::size_t Size() const
+    {
+      return this->expiries.size();
+    }
+
+    /// \brief Heap entry.
+    private: struct Entry
+    {
+      /// \brief Expiry time when the entry was added.
+      Duration expiry;
+
+      /// \brief Marker.
+      MarkerKey key;
+    };
+
+    /// \brief Heap order, earliest expiry on top.
+    private: struct Later
+    {
+      bool operator()(const Entry &_a, const Entry &_b) const
+      {
+        return _a.expiry > _b.expiry;
+      }
+    };
+
+    /// \brief Rebuild the heap from the live expiries once it's mostly
+    /// stale entries.
+    private: void Compact()
+    {
+      if (this->stale < 64u || this->stale < this->expiries.size())
+        return;
+
+      this->heap.clear();
+      for (const auto &[key, expiry] : this->expiries)
+        this->heap.push_back({expiry, key});
+      std::make_heap(this->heap.begin(), this->heap.end(), Later());
+      this->stale = 0u;
+    }
+
+    /// \brief Min-heap of expiries, including stale entries.
+    private: std::vector<Entry> heap;
+
+    /// \brief Current expiry of each marker. An ordered map groups them by
+    /// namespace.
+    private: std::map<MarkerKey, Duration> expiries;
+
+    /// \brief Number of heap entries whose marker was erased or has a
+    /// different expiry.
+    private: std::size_t stale{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_EXPIRYQUEUE_HH_
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "ExpiryQueue.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(ExpiryQueueTest, PopExpired)
+{
+  ExpiryQueue queue;
+  queue.Set({"a", 1u}, 3s);
+  queue.Set({"a", 2u}, 1s);
+  queue.Set({"b", 1u}, 2s);
+  queue.Set({"b", 2u}, 0s);
+  EXPECT_EQ(3u, queue.Size());
+
+  std::vector<MarkerKey> expired;
+  auto collect = [&expired](const MarkerKey &_key)
+  {
+    expired.push_back(_key);
+  };
+
+  EXPECT_EQ(0u, queue.PopExpired(500ms, collect));
+
+  // All expired markers at once, earliest first
+  EXPECT_EQ(2u, queue.PopExpired(2s, collect));
+  ASSERT_EQ(2u, expired.size());
+  EXPECT_EQ(MarkerKey("a", 2u), expired[0]);
+  EXPECT_EQ(MarkerKey("b", 1u), expired[1]);
+  EXPECT_EQ(1u, queue.Size());
+
+  EXPECT_EQ(1u, queue.PopExpired(ExpiryQueue::Duration::max(), collect));
+  EXPECT_EQ(0u, queue.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(ExpiryQueueTest, Update)
+{
+  ExpiryQueue queue;
+  std::vector<MarkerKey> expired;
+  auto collect = [&expired](const MarkerKey &_key)
+  {
+    expired.push_back(_key);
+  };
+
+  // Only the latest expiry counts
+  queue.Set({"a", 1u}, 1s);
+  queue.Set({"a", 1u}, 5s);
+  queue.Set({"a", 2u}, 1s);
+  queue.Set({"a", 2u}, 0s);
+  EXPECT_EQ(1u, queue.Size());
+  EXPECT_EQ(0u, queue.PopExpired(4s, collect));
+  EXPECT_EQ(1u, queue.PopExpired(5s, collect));
+  EXPECT_EQ(MarkerKey("a", 1u), expired.back());
+
+  // Erased markers don't expire
+  queue.Set({"a", 1u}, 1s);
+  queue.Set({"b", 1u}, 1s);
+  queue.Set({"b", 2u}, 1s);
+  queue.Set({"c", 1u}, 1s);
+  EXPECT_TRUE(queue.Erase({"a", 1u}));
+  EXPECT_FALSE(queue.Erase({"a", 1u}));
+  queue.EraseNamespace("b");
+  EXPECT_EQ(1u, queue.Size());
+  expired.clear();
+  EXPECT_EQ(1u, queue.PopExpired(1s, collect));
+  EXPECT_EQ(MarkerKey("c", 1u), expired.back());
+
+  // Many updates to the same marker don't pile up
+  for (int i = 1; i <= 1000; ++i)
+    queue.Set({"d", 1u}, std::chrono::milliseconds(i));
+  EXPECT_EQ(1u, queue.Size());
+  expired.clear();
+  EXPECT_EQ(1u, queue.PopExpired(1s, collect));
+  EXPECT_EQ(1u, expired.size());
+
+  queue.Set({"e", 1u}, 1s);
+  queue.Clear();
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_EQ(0u, queue.PopExpired(1s, collect));
+}
@@ -16,15 +16,19 @@
 */
 
 #include <algorithm>
-#include <list>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <string>
+#include <utility>
 
 #include <QQmlProperty>
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/marker.pb.h>
 #include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/world_stats.pb.h>
 
 #include <gz/common/Console.hh>
@@ -47,7 +51,11 @@
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
 
+#include "ExpiryQueue.hh"
 #include "MarkerManager.hh"
+#include "MarkerPoints.hh"
+#include "MarkerQueue.hh"
+#include "MaterialPool.hh"
 
 namespace gz::gui::plugins
 {
@@ -81,6 +89,9 @@ class MarkerManager::Implementation
   public: bool OnMarkerMsgArray(const gz::msgs::Marker_V &_req,
               gz::msgs::Boolean &_res);
 
+  /// \brief Publish the marker queue statistics once per period
+  public: void UpdateQueueStats();
+
   /// \brief Subscriber callback when new world statistics are received
   public: void OnWorldStatsMsg(const gz::msgs::WorldStatistics &_msg);
 
@@ -103,6 +114,10 @@ class MarkerManager::Implementation
   public: rendering::MaterialPtr MsgToMaterial(
     const gz::msgs::Marker &_msg);
 
+  /// \brief Destroys a marker visual and releases its materials.
+  /// \param[in] _visualPtr The marker visual.
+  public: void DestroyMarkerVisual(const rendering::VisualPtr &_visualPtr);
+
   /// \brief Converts a Gazebo msg render type to Gazebo Rendering
   /// \param[in] _msg The message data
   /// \return Converted rendering type, if any.
@@ -115,13 +130,50 @@ class MarkerManager::Implementation
   /// \brief Mutex to protect message list.
   public: std::mutex mutex;
 
-  /// \brief List of marker message to process.
-  public: std::list<gz::msgs::Marker> markerMsgs;
+  /// \brief Marker messages to process, merged by marker.
+  public: MarkerQueue markerMsgs;
+
+  /// \brief Maximum time spent processing marker messages per frame. Zero
+  /// to process all messages in one frame.
+  public: std::chrono::steady_clock::duration processBudget{0};
+
+  /// \brief Maximum number of marker messages processed per frame. Zero for
+  /// no limit.
+  public: unsigned int maxMsgsPerFrame{0u};
+
+  /// \brief Topic to publish marker queue statistics on, empty to not
+  /// publish them
+  public: std::string queueStatsTopic;
+
+  /// \brief Publisher of marker queue statistics
+  public: transport::Node::Publisher queueStatsPub;
+
+  /// \brief Start of the current statistics period
+  public: std::chrono::steady_clock::time_point queueStatsStart;
+
+  /// \brief Number of marker messages received in the current period
+  public: std::uint64_t receivedMsgs{0u};
+
+  /// \brief Number of marker messages processed in the current period
+  public: std::uint64_t processedMsgs{0u};
+
+  /// \brief Coalesced total at the start of the period
+  public: std::uint64_t lastCoalesced{0u};
+
+  /// \brief Dropped total at the start of the period
+  public: std::uint64_t lastDropped{0u};
 
   /// \brief Map of visuals
   public: std::map<std::string,
       std::map<uint64_t, gz::rendering::VisualPtr>> visuals;
 
+  /// \brief Markers with a lifetime, ordered by when they expire
+  public: ExpiryQueue expiry;
+
+  /// \brief Materials markers are cloned from, keyed by contents and
+  /// referenced by marker id
+  public: MaterialPool<rendering::MaterialPtr> materials;
+
   /// \brief Gazebo node
   public: gz::transport::Node node {gz::transport::NodeOptions()};
 
@@ -202,47 +254,99 @@ void MarkerManager::Implementation::OnRender()
   }
 
   std::lock_guard<std::mutex> lock(this->mutex);
-  // Process the marker messages.
-  for (auto markerIter = this->markerMsgs.begin();
-       markerIter != this->markerMsgs.end();)
+  // Process the marker messages, leaving the rest for the next frames once
+  // the budget is used up.
+  const auto start = std::chrono::steady_clock::now();
+  unsigned int processed{0u};
+  gz::msgs::Marker markerMsg;
+  while (this->markerMsgs.Pop(markerMsg))
   {
-    this->ProcessMarkerMsg(*markerIter);
-    this->markerMsgs.erase(markerIter++);
+    this->ProcessMarkerMsg(markerMsg);
+    ++processed;
+
+    if (this->maxMsgsPerFrame > 0u && processed >= this->maxMsgsPerFrame)
+      break;
+    if (this->processBudget.count() > 0 &&
+        std::chrono::steady_clock::now() - start >= this->processBudget)
+    {
+      break;
+    }
   }
+  this->processedMsgs += processed;
 
-  // Erase any markers that have a lifetime.
-  for (auto mit = this->visuals.begin();
-       mit != this->visuals.end();)
+  // Erase the markers whose lifetime ended, or all markers with a lifetime
+  // if time went backwards.
+  const auto now = this->simTime < this->lastSimTime ?
+      ExpiryQueue::Duration::max() : this->simTime;
+  this->expiry.PopExpired(now, [this](const MarkerKey &_key)
   {
-    for (auto it = mit->second.cbegin();
-         it != mit->second.cend(); ++it)
-    {
-      if (it->second->GeometryCount() == 0u)
-        continue;
+    auto nsIter = this->visuals.find(_key.first);
+    if (nsIter == this->visuals.end())
+      return;
 
-      gz::rendering::MarkerPtr markerPtr =
-            std::dynamic_pointer_cast<gz::rendering::Marker>
-            (it->second->GeometryByIndex(0u));
-      if (markerPtr != nullptr)
-      {
-        if (markerPtr->Lifetime().count() != 0 &&
-            (markerPtr->Lifetime() <= this->simTime ||
-            this->simTime < this->lastSimTime))
-        {
-          this->scene->DestroyVisual(it->second);
-          it = mit->second.erase(it);
-          break;
-        }
-      }
-    }
+    auto it = nsIter->second.find(_key.second);
+    if (it == nsIter->second.end())
+      return;
+
+    this->DestroyMarkerVisual(it->second);
+    nsIter->second.erase(it);
 
     // Erase a namespace if it's empty
-    if (mit->second.empty())
-      mit = this->visuals.erase(mit);
-    else
-      ++mit;
-  }
+    if (nsIter->second.empty())
+      this->visuals.erase(nsIter);
+  });
   this->lastSimTime = this->simTime;
+
+  this->UpdateQueueStats();
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::UpdateQueueStats()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (this->queueStatsStart == std::chrono::steady_clock::time_point())
+    this->queueStatsStart = now;
+  if (now - this->queueStatsStart < std::chrono::seconds(1))
+    return;
+
+  const std::uint64_t coalesced =
+      this->markerMsgs.CoalescedCount() - this->lastCoalesced;
+  const std::uint64_t dropped =
+      this->markerMsgs.DroppedCount() - this->lastDropped;
+  if (dropped > 0u)
+  {
+    gzwarn << "Dropped " << dropped << " marker messages, the queue is "
+           << "full" << std::endl;
+  }
+
+  if (this->queueStatsPub)
+  {
+    const double period =
+        std::chrono::duration<double>(now - this->queueStatsStart).count();
+    gz::msgs::Param statsMsg;
+    auto &params = *statsMsg.mutable_params();
+    params["period"].set_type(gz::msgs::Any::DOUBLE);
+    params["period"].set_double_value(period);
+    const std::pair<const char *, std::uint64_t> counters[] = {
+        {"received", this->receivedMsgs},
+        {"processed", this->processedMsgs},
+        {"coalesced", coalesced},
+        {"dropped", dropped},
+        {"queued", this->markerMsgs.Size()}};
+    for (const auto &[name, value] : counters)
+    {
+      params[name].set_type(gz::msgs::Any::INT32);
+      params[name].set_int_value(static_cast<std::int32_t>(std::min<
+          std::uint64_t>(value, std::numeric_limits<std::int32_t>::max())));
+    }
+    this->queueStatsPub.Publish(statsMsg);
+  }
+
+  this->receivedMsgs = 0u;
+  this->processedMsgs = 0u;
+  this->lastCoalesced = this->markerMsgs.CoalescedCount();
+  this->lastDropped = this->markerMsgs.DroppedCount();
+  this->queueStatsStart = now;
 }
 
 /////////////////////////////////////////////////
@@ -269,7 +373,8 @@ bool MarkerManager::Implementation::OnList(gz::msgs::Marker_V &_rep)
 void MarkerManager::Implementation::OnMarkerMsg(const gz::msgs::Marker &_req)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->markerMsgs.push_back(_req);
+  this->markerMsgs.Push(_req);
+  ++this->receivedMsgs;
 }
 
 /////////////////////////////////////////////////
@@ -277,8 +382,9 @@ bool MarkerManager::Implementation::OnMarkerMsgArray(
     const gz::msgs::Marker_V&_req, gz::msgs::Boolean &_res)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_req.marker().begin(), _req.marker().end(),
-            std::back_inserter(this->markerMsgs));
+  for (const auto &marker : _req.marker())
+    this->markerMsgs.Push(marker);
+  this->receivedMsgs += _req.marker_size();
   _res.set_data(true);
   return true;
 }
@@ -344,6 +450,7 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
 
         // Set the marker values from the Marker Message
         this->SetMarker(_msg, markerPtr);
+        this->expiry.Set({ns, id}, markerPtr->Lifetime());
 
         visualIter->second->AddGeometry(markerPtr);
       }
@@ -366,6 +473,7 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
 
       // Set the marker values from the Marker Message
       this->SetMarker(_msg, markerPtr);
+      this->expiry.Set({ns, id}, markerPtr->Lifetime());
 
       // Add populated marker to the visual
       visualPtr->AddGeometry(markerPtr);
@@ -387,8 +495,9 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
     {
-      this->scene->DestroyVisual(visualIter->second);
+      this->DestroyMarkerVisual(visualIter->second);
       this->visuals[ns].erase(visualIter);
+      this->expiry.Erase({ns, id});
 
       // Remove namespace if empty
       if (this->visuals[ns].empty())
@@ -422,10 +531,11 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
     {
       for (const auto &it : nsIter->second)
       {
-        this->scene->DestroyVisual(it.second);
+        this->DestroyMarkerVisual(it.second);
       }
       nsIter->second.clear();
       this->visuals.erase(nsIter);
+      this->expiry.EraseNamespace(ns);
     }
     // Remove all markers in all namespaces.
     else
@@ -435,10 +545,11 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
       {
         for (const auto &it : nsIter->second)
         {
-          this->scene->DestroyVisual(it.second);
+          this->DestroyMarkerVisual(it.second);
         }
       }
       this->visuals.clear();
+      this->expiry.Clear();
     }
   }
   else
@@ -500,6 +611,24 @@ void MarkerManager::Implementation::SetVisual(const gz::msgs::Marker &_msg,
   // todo(anyone) Update Marker Visibility
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the key of a marker material in the material pool, made of
+/// the values MsgToMaterial reads.
+/// \param[in] _msg Material msg
+/// \return Key
+static std::string materialKey(const msgs::Material &_msg)
+{
+  std::string key;
+  for (const auto *color : {&_msg.ambient(), &_msg.diffuse(),
+      &_msg.specular(), &_msg.emissive()})
+  {
+    const float values[] = {color->r(), color->g(), color->b(), color->a()};
+    key.append(reinterpret_cast<const char *>(values), sizeof(values));
+  }
+  key.push_back(_msg.lighting() ? '1' : '0');
+  return key;
+}
+
 /////////////////////////////////////////////////
 void MarkerManager::Implementation::SetMarker(const gz::msgs::Marker &_msg,
                            const rendering::MarkerPtr &_markerPtr)
@@ -523,14 +652,22 @@ void MarkerManager::Implementation::SetMarker(const gz::msgs::Marker &_msg,
   gz::rendering::MarkerType markerType = MsgToType(_msg);
   _markerPtr->SetType(markerType);
 
-  // Set Marker Material
+  // Set Marker Material. Markers own their material, so they get a clone
+  // of the pooled one, and only when the material changed.
   if (_msg.has_material())
   {
-    rendering::MaterialPtr materialPtr = MsgToMaterial(_msg);
-    _markerPtr->SetMaterial(materialPtr, true /* clone */);
-
-    // clean up material after clone
-    this->scene->DestroyMaterial(materialPtr);
+    const std::string key = materialKey(_msg.material());
+    if (!this->materials.Holds(_markerPtr->Id(), key))
+    {
+      rendering::MaterialPtr materialPtr = this->materials.Acquire(key,
+          _markerPtr->Id(),
+          [this, &_msg]() { return this->MsgToMaterial(_msg); },
+          [this](rendering::MaterialPtr _material)
+          {
+            this->scene->DestroyMaterial(_material);
+          });
+      _markerPtr->SetMaterial(materialPtr, true /* clone */);
+    }
   }
 
   // Assume the presence of points means we clear old ones
@@ -540,26 +677,28 @@ void MarkerManager::Implementation::SetMarker(const gz::msgs::Marker &_msg,
   }
 
   // Set Marker Points
-  for (int i = 0; i < _msg.point().size(); ++i)
-  {
-    math::Vector3d vector(
-        _msg.point(i).x(),
-        _msg.point(i).y(),
-        _msg.point(i).z());
-
-    math::Color color = msgs::Convert(_msg.material().diffuse());
-    if (i < _msg.materials().size())
-    {
-      color = msgs::Convert(_msg.materials(i).diffuse());
-    }
-    _markerPtr->AddPoint(vector, color);
-  }
+  AddMarkerPoints(*_markerPtr, _msg);
   if (_msg.has_scale())
   {
     _markerPtr->SetSize(_msg.scale().x());
   }
 }
 
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::DestroyMarkerVisual(
+    const rendering::VisualPtr &_visualPtr)
+{
+  for (unsigned int i = 0u; i < _visualPtr->GeometryCount(); ++i)
+  {
+    this->materials.Release(_visualPtr->GeometryByIndex(i)->Id(),
+        [this](rendering::MaterialPtr _material)
+        {
+          this->scene->DestroyMaterial(_material);
+        });
+  }
+  this->scene->DestroyVisual(_visualPtr);
+}
+
 /////////////////////////////////////////////////
 rendering::MaterialPtr
 MarkerManager::Implementation::MsgToMaterial(const gz::msgs::Marker &_msg)
@@ -669,6 +808,16 @@ MarkerManager::MarkerManager()
 /////////////////////////////////////////////////
 MarkerManager::~MarkerManager() = default;
 
+/////////////////////////////////////////////////
+/// \brief Get the text of an element, for error messages
+/// \param[in] _elem Element
+/// \return Text, empty if the element has none
+static const char *elementText(const tinyxml2::XMLElement *_elem)
+{
+  const char *text = _elem->GetText();
+  return nullptr != text ? text : "";
+}
+
 /////////////////////////////////////////////////
 void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
 {
@@ -700,7 +849,80 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
           tinyxml2::XML_SUCCESS)
       {
         gzerr << "Failed to parse <warn_on_action_failure> value: "
-               << elem->GetText() << std::endl;
+               << elementText(elem) << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("process_budget_ms")))
+    {
+      double budget{0.0};
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS &&
+          budget >= 0.0)
+      {
+        this->dataPtr->processBudget =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget));
+      }
+      else
+      {
+        gzerr << "Failed to parse <process_budget_ms> value: "
+               << elementText(elem) << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("max_msgs_per_frame")))
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->maxMsgsPerFrame) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Failed to parse <max_msgs_per_frame> value: "
+               << elementText(elem) << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("max_queue_size")))
+    {
+      unsigned int maxQueueSize{0u};
+      if (elem->QueryUnsignedText(&maxQueueSize) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->markerMsgs.SetCapacity(maxQueueSize);
+      }
+      else
+      {
+        gzerr << "Failed to parse <max_queue_size> value: "
+               << elementText(elem) << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("drop_policy")))
+    {
+      const std::string policy = elementText(elem);
+      if (policy == "oldest")
+      {
+        this->dataPtr->markerMsgs.SetDropPolicy(
+            MarkerQueue::DropPolicy::kOldest);
+      }
+      else if (policy == "namespace")
+      {
+        this->dataPtr->markerMsgs.SetDropPolicy(
+            MarkerQueue::DropPolicy::kNamespace);
+      }
+      else
+      {
+        gzerr << "Failed to parse <drop_policy> value: " << policy
+               << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("queue_stats_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->queueStatsTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+      if (this->dataPtr->queueStatsTopic.empty())
+      {
+        gzerr << "Failed to parse <queue_stats_topic> value: "
+               << elementText(elem) << std::endl;
       }
     }
 
@@ -758,6 +980,18 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
            << std::endl;
   }
 
+  if (!this->dataPtr->queueStatsTopic.empty())
+  {
+    this->dataPtr->queueStatsPub =
+        this->dataPtr->node.Advertise<gz::msgs::Param>(
+        this->dataPtr->queueStatsTopic);
+    if (!this->dataPtr->queueStatsPub)
+    {
+      gzerr << "Failed to advertise [" << this->dataPtr->queueStatsTopic
+             << "]" << std::endl;
+    }
+  }
+
   QQmlProperty::write(this->PluginItem(), "topicName",
       QString::fromStdString(this->dataPtr->topicName));
   QQmlProperty::write(this->PluginItem(), "statsTopic",
@@ -36,6 +36,24 @@ namespace gz::gui::plugins
   /// Defaults to `/world/[world name]/stats`.
   /// * `<warn_on_action_failure>`: True to display warnings if the user
   /// attempts to perform an invalid action. Defaults to true.
+  /// * `<process_budget_ms>`: Optional. Maximum time in milliseconds spent
+  /// processing marker messages on each frame. The remaining messages are
+  /// processed on the next frames, and merged with newer messages for the
+  /// same markers meanwhile. Marker lifetimes start when a message is
+  /// processed, so a deferred marker expires later. Defaults to 0, which
+  /// processes all messages in one frame.
+  /// * `<max_msgs_per_frame>`: Optional. Maximum number of marker messages
+  /// processed on each frame. Defaults to 0, no limit.
+  /// * `<max_queue_size>`: Optional. Maximum number of marker messages
+  /// waiting to be processed. Add and modify messages are dropped to make
+  /// room, deletions are always kept. Defaults to 0, no limit.
+  /// * `<drop_policy>`: Optional. Which message is dropped when the queue is
+  /// full. `oldest` drops the oldest add or modify message, and `namespace`
+  /// drops the oldest one of the namespace with the most queued messages.
+  /// Defaults to `oldest`.
+  /// * `<queue_stats_topic>`: Optional. Name of topic to publish the number
+  /// of marker messages received, processed, coalesced, dropped and queued
+  /// every second on, as `gz::msgs::Param`. Not published by default.
   class MarkerManager : public Plugin
   {
     Q_OBJECT
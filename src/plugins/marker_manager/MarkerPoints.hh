@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERPOINTS_HH_
+#define GZ_GUI_PLUGINS_MARKERPOINTS_HH_
+
+#include <gz/math/Color.hh>
+#include <gz/msgs/marker.pb.h>
+
+namespace gz::gui::plugins
+{
+  /// \brief Add the points of a marker message to a marker, reading the
+  /// message fields in place.
+  ///
+  /// Points take the diffuse color of the material at the same index in
+  /// the message's `materials`, or the diffuse color of its `material` if
+  /// there are fewer materials than points.
+  /// \param[in] _marker Marker to add the points to, such as a
+  /// `rendering::Marker`.
+  /// \param[in] _msg Marker message.
+  template <typename MarkerT>
+  void AddMarkerPoints(MarkerT &_marker, const msgs::Marker &_msg)
+  {
+    const auto &points = _msg.point();
+    const auto &materials = _msg.materials();
+
+    const auto &diffuse = _msg.material().diffuse();
+    const math::Color defaultColor(diffuse.r(), diffuse.g(), diffuse.b(),
+        diffuse.a());
+
+    math::Color color;
+    for (int i = 0; i < points.size(); ++i)
+    {
+      const auto &point = points.Get(i);
+      if (i < materials.size())
+      {
+        const auto &pointDiffuse = materials.Get(i).diffuse();
+        color.Set(pointDiffuse.r(), pointDiffuse.g(), pointDiffuse.b(),
+            pointDiffuse.a());
+        _marker.AddPoint(point.x(), point.y(), point.z(), color);
+      }
+      else
+      {
+        _marker.AddPoint(point.x(), point.y(), point.z(), defaultColor);
+      }
+    }
+  }
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MARKERPOINTS_HH_
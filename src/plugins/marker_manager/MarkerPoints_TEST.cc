@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/msgs/marker.pb.h>
+
+#include "MarkerPoints.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Records the points added to it, like a rendering::Marker
+class FakeMarker
+{
+  /// \brief Add a point
+  /// \param[in] _x X
+  /// \param[in] _y Y
+  /// \param[in] _z Z
+  /// \param[in] _color Color
+  public: void AddPoint(double _x, double _y, double _z,
+                        const math::Color &_color)
+  {
+    this->xyz.insert(this->xyz.end(), {_x, _y, _z});
+    this->colors.push_back(_color);
+  }
+
+  /// \brief Point positions
+  public: std::vector<double> xyz;
+
+  /// \brief Point colors
+  public: std::vector<math::Color> colors;
+};
+
+/////////////////////////////////////////////////
+TEST(MarkerPointsTest, Msg)
+{
+  msgs::Marker msg;
+  auto *diffuse = msg.mutable_material()->mutable_diffuse();
+  diffuse->set_b(1);
+  diffuse->set_a(1);
+  for (int i = 0; i < 3; ++i)
+  {
+    auto *point = msg.add_point();
+    point->set_x(i);
+    point->set_y(i + 10);
+    point->set_z(i + 20);
+  }
+  msg.add_materials()->mutable_diffuse()->set_r(1);
+
+  // Points past the per point materials use the marker material
+  FakeMarker marker;
+  AddMarkerPoints(marker, msg);
+  EXPECT_EQ(std::vector<double>({0, 10, 20, 1, 11, 21, 2, 12, 22}),
+      marker.xyz);
+  ASSERT_EQ(3u, marker.colors.size());
+  EXPECT_EQ(math::Color(1, 0, 0, 0), marker.colors[0]);
+  EXPECT_EQ(math::Color(0, 0, 1, 1), marker.colors[1]);
+  EXPECT_EQ(math::Color(0, 0, 1, 1), marker.colors[2]);
+}
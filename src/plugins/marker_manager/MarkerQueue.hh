@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERQUEUE_HH_
+#define GZ_GUI_PLUGINS_MARKERQUEUE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <gz/msgs/marker.pb.h>
+
+#include "ExpiryQueue.hh"
+
+namespace gz::gui::plugins
+{
+  /// \brief Queue of marker messages waiting for the render thread, which
+  /// only keeps their net effect.
+  ///
+  /// * An ADD_MODIFY for a marker which already has an ADD_MODIFY of the
+  ///   same type queued is merged into the queued one, in its place. Fields
+  ///   the new message leaves out keep the queued values, as if both had
+  ///   been applied. Messages which change the parent are queued as is, so
+  ///   the parent they refer to is created first. So are messages of
+  ///   another type, since the type decides how fields such as the scale
+  ///   are applied.
+  /// * A DELETE_MARKER drops the queued ADD_MODIFY of that marker.
+  /// * A DELETE_ALL drops every queued message of its namespace, or every
+  ///   queued message if it has no namespace.
+  ///
+  /// Markers without an id get a random id, so they're never merged.
+  ///
+  /// The queue can be bounded, in which case ADD_MODIFY messages are
+  /// dropped to make room, following a drop policy. Deletions are never
+  /// dropped, so markers aren't left behind.
+  class MarkerQueue
+  {
+    /// \brief Which message to drop when the queue is full.
+    public: enum class DropPolicy
+    {
+      /// \brief The oldest ADD_MODIFY message
+      kOldest,
+
+      /// \brief The oldest ADD_MODIFY message of the namespace with the
+      /// most queued ADD_MODIFY messages, so a namespace flooding the
+      /// queue doesn't starve the others
+      kNamespace
+    };
+
+    /// \brief Set the maximum number of queued messages. Deletions are
+    /// queued even beyond it.
+    /// \param[in] _capacity Maximum number of messages, 0 for no limit.
+    public: void SetCapacity(std::size_t _capacity)
+    {
+      this->capacity = _capacity;
+    }
+
+    /// \brief Set which message is dropped when the queue is full.
+    /// \param[in] _policy Drop policy.
+    public: void SetDropPolicy(DropPolicy _policy)
+    {
+      this->dropPolicy = _policy;
+    }
+
+    /// \brief Queue a message.
+    /// \param[in] _msg Marker message.
+    public: void Push(msgs::Marker _msg)
+    {
+      const MarkerKey key{_msg.ns(), _msg.id()};
+      switch (_msg.action())
+      {
+        case msgs::Marker::ADD_MODIFY:
+        {
+          if (_msg.id() == 0u)
+            break;
+
+          auto it = this->pending.find(key);
+          if (it != this->pending.end() && _msg.parent().empty() &&
+              _msg.type() == it->second->type())
+          {
+            Merge(*it->second, std::move(_msg));
+            ++this->coalesced;
+            return;
+          }
+          this->Append(std::move(_msg));
+          this->pending[key] = std::prev(this->queue.end());
+          this->Trim();
+          return;
+        }
+        case msgs::Marker::DELETE_MARKER:
+        {
+          auto it = this->pending.find(key);
+          if (it != this->pending.end())
+          {
+            this->EraseAt(it->second);
+            ++this->coalesced;
+          }
+          break;
+        }
+        case msgs::Marker::DELETE_ALL:
+        {
+          if (_msg.ns().empty())
+          {
+            this->coalesced += this->queue.size();
+            this->queue.clear();
+            this->pending.clear();
+            this->addCounts.clear();
+            break;
+          }
+
+          for (auto it = this->queue.begin(); it != this->queue.end();)
+          {
+            if (it->ns() == _msg.ns())
+            {
+              it = this->EraseAt(it);
+              ++this->coalesced;
+            }
+            else
+            {
+              ++it;
+            }
+          }
+          break;
+        }
+        default:
+          break;
+      }
+      this->Append(std::move(_msg));
+      this->Trim();
+    }
+
+    /// \brief Take the oldest message.
+    /// \param[out] _msg Message.
+    /// \return False if the queue is empty.
+    public: bool Pop(msgs::Marker &_msg)
+    {
+      if (this->queue.empty())
+        return false;
+
+      this->Forget(this->queue.begin());
+      _msg = std::move(this->queue.front());
+      this->queue.pop_front();
+      return true;
+    }
+
+    /// \brief Number of queued messages.
+    /// \return Number of messages.
+    public: std::size_t Size() const
+    {
+      return this->queue.size();
+    }
+
+    /// \brief Whether there are no queued messages.
+    /// \return True if empty.
+    public: bool Empty() const
+    {
+      return this->queue.empty();
+    }
+
+    /// \brief Number of messages merged or dropped because a later message
+    /// superseded them.
+    /// \return Number of messages.
+    public: std::uint64_t CoalescedCount() const
+    {
+      return this->coalesced;
+    }
+
+    /// \brief Number of messages dropped because the queue was full.
+    /// \return Number of messages.
+    public: std::uint64_t DroppedCount() const
+    {
+      return this->dropped;
+    }
+
+    /// \brief Merge an ADD_MODIFY message into an earlier one of the same
+    /// type for the same marker, so applying the result is like applying
+    /// both in order.
+    /// \param[in, out] _into Earlier message, replaced by the result.
+    /// \param[in] _later Later message.
+    public: static void Merge(msgs::Marker &_into, msgs::Marker &&_later)
+    {
+      // Points replace the previous points, and the per point materials
+      // only apply to them
+      if (_later.point().empty())
+      {
+        _later.mutable_point()->Swap(_into.mutable_point());
+        _later.mutable_materials()->Swap(_into.mutable_materials());
+      }
+      if (!_later.has_material() && _into.has_material())
+        _later.mutable_material()->Swap(_into.mutable_material());
+      if (!_later.has_scale() && _into.has_scale())
+        _later.mutable_scale()->Swap(_into.mutable_scale());
+      if (!_later.has_pose() && _into.has_pose())
+        _later.mutable_pose()->Swap(_into.mutable_pose());
+      if (_later.parent().empty())
+        _later.set_parent(_into.parent());
+
+      _into = std::move(_later);
+    }
+
+    /// \brief Queued message iterator.
+    private: using Iterator = std::list<msgs::Marker>::iterator;
+
+    /// \brief Add a message at the back of the queue.
+    /// \param[in] _msg Message.
+    private: void Append(msgs::Marker &&_msg)
+    {
+      if (_msg.action() == msgs::Marker::ADD_MODIFY)
+        ++this->addCounts[_msg.ns()];
+      this->queue.push_back(std::move(_msg));
+    }
+
+    /// \brief Stop indexing a queued message which is about to be removed.
+    /// \param[in] _it Message.
+    private: void Forget(Iterator _it)
+    {
+      if (_it->action() != msgs::Marker::ADD_MODIFY)
+        return;
+
+      auto count = this->addCounts.find(_it->ns());
+      if (--count->second == 0u)
+        this->addCounts.erase(count);
+
+      auto it = this->pending.find({_it->ns(), _it->id()});
+      if (it != this->pending.end() && it->second == _it)
+        this->pending.erase(it);
+    }
+
+    /// \brief Remove a queued message.
+    /// \param[in] _it Message.
+    /// \return Next message.
+    private: Iterator EraseAt(Iterator _it)
+    {
+      this->Forget(_it);
+      return this->queue.erase(_it);
+    }
+
+    /// \brief Drop ADD_MODIFY messages until the queue fits its capacity.
+    private: void Trim()
+    {
+      while (this->capacity > 0u && this->queue.size() > this->capacity &&
+             !this->addCounts.empty())
+      {
+        const std::string *ns{nullptr};
+        if (this->dropPolicy == DropPolicy::kNamespace)
+        {
+          std::size_t most{0u};
+          for (const auto &[name, count] : this->addCounts)
+          {
+            if (count > most)
+            {
+              most = count;
+              ns = &name;
+            }
+          }
+        }
+
+        auto it = this->queue.begin();
+        while (it->action() != msgs::Marker::ADD_MODIFY ||
+               (nullptr != ns && it->ns() != *ns))
+        {
+          ++it;
+        }
+        this->EraseAt(it);
+        ++this->dropped;
+      }
+    }
+
+    /// \brief Queued messages, oldest first.
+    private: std::list<msgs::Marker> queue;
+
+    /// \brief Queued ADD_MODIFY message which later ones for the same
+    /// marker are merged into. Ordered so a namespace can be erased at once.
+    private: std::map<MarkerKey,
+        std::list<msgs::Marker>::iterator> pending;
+
+    /// \brief Number of queued ADD_MODIFY messages in each namespace.
+    private: std::map<std::string, std::size_t> addCounts;
+
+    /// \brief Maximum number of queued messages, 0 for no limit.
+    private: std::size_t capacity{0u};
+
+    /// \brief Which message to drop when the queue is full.
+    private: DropPolicy dropPolicy{DropPolicy::kOldest};
+
+    /// \brief Number of messages merged or dropped because a later message
+    /// superseded them.
+    private: std::uint64_t coalesced{0u};
+
+    /// \brief Number of messages dropped because the queue was full.
+    private: std::uint64_t dropped{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MARKERQUEUE_HH_
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gz/msgs/marker.pb.h>
+
+#include "MarkerQueue.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Create a marker message
+/// \param[in] _action Action
+/// \param[in] _ns Namespace
+/// \param[in] _id Id
+/// \return Message
+static msgs::Marker makeMarker(msgs::Marker::Action _action,
+    const std::string &_ns, std::uint64_t _id)
+{
+  msgs::Marker msg;
+  msg.set_action(_action);
+  msg.set_ns(_ns);
+  msg.set_id(_id);
+  return msg;
+}
+
+/// \brief Take all queued messages
+/// \param[in] _queue Queue
+/// \return Messages, oldest first
+static std::vector<msgs::Marker> popAll(MarkerQueue &_queue)
+{
+  std::vector<msgs::Marker> result;
+  msgs::Marker msg;
+  while (_queue.Pop(msg))
+    result.push_back(msg);
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerQueueTest, MergeAddModify)
+{
+  MarkerQueue queue;
+
+  auto first = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  first.set_type(msgs::Marker::POINTS);
+  first.add_point()->set_x(1.0);
+  first.mutable_material()->mutable_diffuse()->set_r(1.0f);
+  first.mutable_scale()->set_x(2.0);
+  first.mutable_lifetime()->set_sec(5);
+  queue.Push(first);
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "b", 1u));
+
+  auto second = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  second.set_type(msgs::Marker::POINTS);
+  second.mutable_pose()->mutable_position()->set_z(3.0);
+  second.set_layer(2);
+  queue.Push(second);
+
+  auto third = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  third.set_type(msgs::Marker::POINTS);
+  third.add_point()->set_x(4.0);
+  third.add_point()->set_x(5.0);
+  queue.Push(third);
+
+  EXPECT_EQ(2u, queue.Size());
+  EXPECT_EQ(2u, queue.CoalescedCount());
+
+  // Merged in place, keeping fields later messages left out
+  auto queued = popAll(queue);
+  ASSERT_EQ(2u, queued.size());
+  const auto &merged = queued[0];
+  EXPECT_EQ("a", merged.ns());
+  EXPECT_EQ(msgs::Marker::POINTS, merged.type());
+  ASSERT_EQ(2, merged.point_size());
+  EXPECT_DOUBLE_EQ(4.0, merged.point(0).x());
+  EXPECT_FLOAT_EQ(1.0f, merged.material().diffuse().r());
+  EXPECT_DOUBLE_EQ(2.0, merged.scale().x());
+  EXPECT_DOUBLE_EQ(3.0, merged.pose().position().z());
+  EXPECT_EQ(0, merged.lifetime().sec());
+  EXPECT_EQ(0, merged.layer());
+  EXPECT_EQ("b", queued[1].ns());
+
+  // Once taken, later messages aren't merged into it
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  EXPECT_EQ(1u, queue.Size());
+
+  // Markers without id and messages changing the parent aren't merged
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 0u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 0u));
+  auto reparent = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  reparent.set_parent("parent");
+  queue.Push(reparent);
+  EXPECT_EQ(4u, queue.Size());
+  EXPECT_EQ(2u, queue.CoalescedCount());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerQueueTest, TypeChange)
+{
+  MarkerQueue queue;
+
+  auto points = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  points.set_type(msgs::Marker::POINTS);
+  points.mutable_scale()->set_x(0.5);
+  queue.Push(points);
+
+  // The scale of a box is the visual's scale, not the point size, so the
+  // messages are applied one after the other
+  auto box = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  box.set_type(msgs::Marker::BOX);
+  queue.Push(box);
+
+  EXPECT_EQ(2u, queue.Size());
+  EXPECT_EQ(0u, queue.CoalescedCount());
+
+  // Later messages of the same type merge into the newest one
+  auto box2 = makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u);
+  box2.set_type(msgs::Marker::BOX);
+  box2.mutable_pose()->mutable_position()->set_z(1.0);
+  queue.Push(box2);
+  EXPECT_EQ(2u, queue.Size());
+  EXPECT_EQ(1u, queue.CoalescedCount());
+
+  // Leaving the type out doesn't merge
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  EXPECT_EQ(3u, queue.Size());
+
+  auto queued = popAll(queue);
+  ASSERT_EQ(3u, queued.size());
+  EXPECT_EQ(msgs::Marker::POINTS, queued[0].type());
+  EXPECT_DOUBLE_EQ(0.5, queued[0].scale().x());
+  EXPECT_EQ(msgs::Marker::BOX, queued[1].type());
+  EXPECT_FALSE(queued[1].has_scale());
+  EXPECT_DOUBLE_EQ(1.0, queued[1].pose().position().z());
+  EXPECT_EQ(msgs::Marker::NONE, queued[2].type());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerQueueTest, Delete)
+{
+  MarkerQueue queue;
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 2u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "b", 1u));
+
+  // Deleting a marker drops its queued update
+  queue.Push(makeMarker(msgs::Marker::DELETE_MARKER, "a", 1u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  auto queued = popAll(queue);
+  ASSERT_EQ(4u, queued.size());
+  EXPECT_EQ(2u, queued[0].id());
+  EXPECT_EQ("b", queued[1].ns());
+  EXPECT_EQ(msgs::Marker::DELETE_MARKER, queued[2].action());
+  EXPECT_EQ(msgs::Marker::ADD_MODIFY, queued[3].action());
+  EXPECT_EQ(1u, queue.CoalescedCount());
+
+  // Deleting a namespace drops its queued messages
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "b", 1u));
+  queue.Push(makeMarker(msgs::Marker::DELETE_MARKER, "a", 3u));
+  queue.Push(makeMarker(msgs::Marker::DELETE_ALL, "a", 0u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  queued = popAll(queue);
+  ASSERT_EQ(3u, queued.size());
+  EXPECT_EQ("b", queued[0].ns());
+  EXPECT_EQ(msgs::Marker::DELETE_ALL, queued[1].action());
+  EXPECT_EQ(msgs::Marker::ADD_MODIFY, queued[2].action());
+  EXPECT_EQ(3u, queue.CoalescedCount());
+
+  // Deleting everything drops everything queued
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "b", 1u));
+  queue.Push(makeMarker(msgs::Marker::DELETE_ALL, "", 0u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "b", 1u));
+  queued = popAll(queue);
+  ASSERT_EQ(2u, queued.size());
+  EXPECT_EQ(msgs::Marker::DELETE_ALL, queued[0].action());
+  EXPECT_EQ("b", queued[1].ns());
+  EXPECT_EQ(5u, queue.CoalescedCount());
+  EXPECT_TRUE(queue.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerQueueTest, Capacity)
+{
+  MarkerQueue queue;
+  queue.SetCapacity(3u);
+
+  // The oldest updates make room, deletions are kept
+  queue.Push(makeMarker(msgs::Marker::DELETE_MARKER, "a", 10u));
+  for (std::uint64_t id = 1u; id <= 4u; ++id)
+    queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", id));
+  EXPECT_EQ(3u, queue.Size());
+  EXPECT_EQ(2u, queue.DroppedCount());
+
+  // Merging doesn't take room
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 4u));
+  EXPECT_EQ(2u, queue.DroppedCount());
+
+  auto queued = popAll(queue);
+  ASSERT_EQ(3u, queued.size());
+  EXPECT_EQ(msgs::Marker::DELETE_MARKER, queued[0].action());
+  EXPECT_EQ(3u, queued[1].id());
+  EXPECT_EQ(4u, queued[2].id());
+
+  // A dropped update isn't merged into
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 2u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 3u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 4u));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "a", 1u));
+  EXPECT_EQ(3u, queue.Size());
+  EXPECT_EQ(4u, queue.DroppedCount());
+  queued = popAll(queue);
+  ASSERT_EQ(3u, queued.size());
+  EXPECT_EQ(3u, queued[0].id());
+  EXPECT_EQ(4u, queued[1].id());
+  EXPECT_EQ(1u, queued[2].id());
+
+  // Only deletions left
+  for (std::uint64_t id = 1u; id <= 4u; ++id)
+    queue.Push(makeMarker(msgs::Marker::DELETE_MARKER, "a", id));
+  EXPECT_EQ(4u, queue.Size());
+  EXPECT_EQ(4u, queue.DroppedCount());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerQueueTest, DropByNamespace)
+{
+  MarkerQueue queue;
+  queue.SetCapacity(4u);
+  queue.SetDropPolicy(MarkerQueue::DropPolicy::kNamespace);
+
+  // The namespace with the most queued updates makes room
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "quiet", 1u));
+  for (std::uint64_t id = 1u; id <= 10u; ++id)
+    queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "busy", id));
+  queue.Push(makeMarker(msgs::Marker::ADD_MODIFY, "quiet", 2u));
+  EXPECT_EQ(4u, queue.Size());
+  EXPECT_EQ(8u, queue.DroppedCount());
+
+  auto queued = popAll(queue);
+  ASSERT_EQ(4u, queued.size());
+  EXPECT_EQ("quiet", queued[0].ns());
+  EXPECT_EQ(1u, queued[0].id());
+  EXPECT_EQ("busy", queued[1].ns());
+  EXPECT_EQ(9u, queued[1].id());
+  EXPECT_EQ("busy", queued[2].ns());
+  EXPECT_EQ(10u, queued[2].id());
+  EXPECT_EQ("quiet", queued[3].ns());
+}
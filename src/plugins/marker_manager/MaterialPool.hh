@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MATERIALPOOL_HH_
+#define GZ_GUI_PLUGINS_MATERIALPOOL_HH_
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace gz::gui::plugins
+{
+  /// \brief Reference counted materials keyed by the contents they were
+  /// created from, where each user holds at most one material.
+  ///
+  /// Users are identified by an id such as the marker id. Switching a user
+  /// to a new key releases its previous material, and a material is handed
+  /// to a release callback once its last user is gone.
+  ///
+  /// \tparam MaterialPtrT Shared material handle, e.g.
+  /// `rendering::MaterialPtr`.
+  template <typename MaterialPtrT>
+  class MaterialPool
+  {
+    /// \brief Whether a user holds the material for a key.
+    /// \param[in] _user User id.
+    /// \param[in] _key Material contents.
+    /// \return True if the user's material has that key.
+    public: bool Holds(unsigned int _user, const std::string &_key) const
+    {
+      auto it = this->users.find(_user);
+      return it != this->users.end() && it->second->first == _key;
+    }
+
+    /// \brief Get the material for a key, creating it if no user holds it,
+    /// and make it the material of a user.
+    /// \param[in] _key Contents the material is created from.
+    /// \param[in] _user User id.
+    /// \param[in] _create Callback invoked as `MaterialPtrT()` to create
+    /// the material when it's not in the pool.
+    /// \param[in] _release Callback invoked as `void(MaterialPtrT)` if the
+    /// user's previous material lost its last reference.
+    /// \return The shared material. Null if creation failed, in which case
+    /// the user keeps its previous material.
+    public: template <typename CreateFn, typename ReleaseFn>
+            MaterialPtrT Acquire(const std::string &_key, unsigned int _user,
+                                 CreateFn &&_create, ReleaseFn &&_release)
+    {
+      auto userIt = this->users.find(_user);
+      if (userIt != this->users.end() && userIt->second->first == _key)
+        return userIt->second->second.material;
+
+      auto it = this->materials.find(_key);
+      if (it == this->materials.end())
+      {
+        MaterialPtrT material = _create();
+        if (!material)
+          return material;
+        it = this->materials.emplace(_key, Entry{material, 0u}).first;
+      }
+      ++it->second.refCount;
+
+      if (userIt != this->users.end())
+      {
+        this->Unref(userIt->second, _release);
+        userIt->second = &*it;
+      }
+      else
+      {
+        this->users.emplace(_user, &*it);
+      }
+      return it->second.material;
+    }
+
+    /// \brief Release the material held by a user.
+    /// \param[in] _user User id.
+    /// \param[in] _release Callback invoked as `void(MaterialPtrT)` if the
+    /// material lost its last reference.
+    /// \return True if the user held a material.
+    public: template <typename ReleaseFn>
+            bool Release(unsigned int _user, ReleaseFn &&_release)
+    {
+      auto userIt = this->users.find(_user);
+      if (userIt == this->users.end())
+        return false;
+
+      this->Unref(userIt->second, _release);
+      this->users.erase(userIt);
+      return true;
+    }
+
+    /// \brief Number of distinct materials.
+    /// \return Number of materials.
+    public: std::size_t Size() const
+    {
+      return this->materials.size();
+    }
+
+    /// \brief Number of users of the material for a key.
+    /// \param[in] _key Material contents.
+    /// \return Reference count, zero if not in the pool.
+    public: std::size_t RefCount(const std::string &_key) const
+    {
+      auto it = this->materials.find(_key);
+      return it == this->materials.end() ? 0u : it->second.refCount;
+    }
+
+    /// \brief A pooled material.
+    private: struct Entry
+    {
+      /// \brief The shared material.
+      MaterialPtrT material;
+
+      /// \brief Number of users.
+      std::size_t refCount;
+    };
+
+    /// \brief Pool element, stable across rehashes.
+    private: using Element = std::pair<const std::string, Entry>;
+
+    /// \brief Drop a reference to a material, releasing it if it was the
+    /// last one.
+    /// \param[in] _element Material.
+    /// \param[in] _release Release callback.
+    private: template <typename ReleaseFn>
+             void Unref(Element *_element, ReleaseFn &_release)
+    {
+      if (--_element->second.refCount > 0u)
+        return;
+
+      MaterialPtrT material = std::move(_element->second.material);
+      this->materials.erase(this->materials.find(_element->first));
+      _release(std::move(material));
+    }
+
+    /// \brief Materials keyed by contents.
+    private: std::unordered_map<std::string, Entry> materials;
+
+    /// \brief Material held by each user.
+    private: std::unordered_map<unsigned int, Element *> users;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MATERIALPOOL_HH_
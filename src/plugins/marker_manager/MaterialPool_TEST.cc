@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MaterialPool.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Stand-in for a rendering material
+struct TestMaterial
+{
+  std::string name;
+};
+
+using TestMaterialPtr = std::shared_ptr<TestMaterial>;
+
+/////////////////////////////////////////////////
+TEST(MaterialPoolTest, Share)
+{
+  MaterialPool<TestMaterialPtr> pool;
+  int created{0};
+  std::vector<std::string> released;
+
+  auto create = [&created](const std::string &_name)
+  {
+    return [&created, _name]()
+    {
+      ++created;
+      return std::make_shared<TestMaterial>(TestMaterial{_name});
+    };
+  };
+  auto release = [&released](TestMaterialPtr _material)
+  {
+    released.push_back(_material->name);
+  };
+
+  // Users of the same contents share one material
+  auto red = pool.Acquire("red", 1u, create("red"), release);
+  EXPECT_EQ(red, pool.Acquire("red", 2u, create("red"), release));
+  EXPECT_TRUE(pool.Holds(1u, "red"));
+  EXPECT_FALSE(pool.Holds(1u, "blue"));
+  EXPECT_FALSE(pool.Holds(3u, "red"));
+
+  // Acquiring the same contents again adds no reference
+  EXPECT_EQ(red, pool.Acquire("red", 1u, create("red"), release));
+  EXPECT_EQ(1, created);
+  EXPECT_EQ(2u, pool.RefCount("red"));
+
+  // Switching contents releases the previous material once unused
+  auto blue = pool.Acquire("blue", 1u, create("blue"), release);
+  EXPECT_NE(red, blue);
+  EXPECT_TRUE(released.empty());
+  EXPECT_EQ(1u, pool.RefCount("red"));
+  pool.Acquire("blue", 2u, create("blue"), release);
+  ASSERT_EQ(1u, released.size());
+  EXPECT_EQ("red", released[0]);
+  EXPECT_EQ(1u, pool.Size());
+
+  // Failed creation keeps the previous material
+  EXPECT_EQ(nullptr, pool.Acquire("green", 1u,
+      []() { return TestMaterialPtr(); }, release));
+  EXPECT_TRUE(pool.Holds(1u, "blue"));
+
+  EXPECT_TRUE(pool.Release(1u, release));
+  EXPECT_FALSE(pool.Release(1u, release));
+  EXPECT_EQ(1u, released.size());
+  EXPECT_TRUE(pool.Release(2u, release));
+  ASSERT_EQ(2u, released.size());
+  EXPECT_EQ("blue", released[1]);
+  EXPECT_EQ(0u, pool.Size());
+  EXPECT_EQ(2, created);
+}
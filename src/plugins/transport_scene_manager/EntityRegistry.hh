@@ -0,0 +1,487 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_ENTITYREGISTRY_HH_
+#define GZ_GUI_PLUGINS_ENTITYREGISTRY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Kind of rendering object an entity is mirrored as.
+  enum class EntityType : std::uint8_t
+  {
+    /// \brief Model, link or visual, mirrored as a rendering visual.
+    kVisual,
+
+    /// \brief Light, mirrored as a rendering light.
+    kLight
+  };
+
+  /// \brief Dense table of the entities mirrored by a scene manager.
+  ///
+  /// Entities are stored contiguously in slots, and a hash index maps entity
+  /// ids to slots. Each slot caches a weak handle to the rendering node, so
+  /// applying a pose is a hash lookup at staging time followed by a linear
+  /// sweep over the staged slots, instead of a tree walk per pose.
+  ///
+  /// Each slot also records its parent entity and children, so a whole
+  /// subtree can be removed by walking the registry instead of the scene
+  /// graph.
+  ///
+  /// Slots are not stable: removing an entity moves the last slot into the
+  /// freed position. Slot references must not be kept across calls to
+  /// Remove or Add.
+  ///
+  /// \tparam NodeT Rendering node type, i.e. gz::rendering::Node.
+  template <typename NodeT>
+  class EntityRegistry
+  {
+    /// \brief Data stored for each entity.
+    public: struct Slot
+    {
+      /// \brief Entity id.
+      unsigned int id{0u};
+
+      /// \brief Kind of rendering object.
+      EntityType type{EntityType::kVisual};
+
+      /// \brief Cached handle to the rendering node.
+      std::weak_ptr<NodeT> node;
+
+      /// \brief Additional local pose applied after every incoming pose.
+      /// This is currently used to handle the normal vector in plane
+      /// visuals.
+      math::Pose3d localPose{math::Pose3d::Zero};
+
+      /// \brief Pose staged to be applied on the next sweep, already
+      /// combined with the local pose.
+      math::Pose3d pose{math::Pose3d::Zero};
+
+      /// \brief True if the slot is in the staged list.
+      bool staged{false};
+
+      /// \brief Last pose applied to the node.
+      math::Pose3d appliedPose{math::Pose3d::Zero};
+
+      /// \brief True once a pose has been applied to the node.
+      bool hasAppliedPose{false};
+
+      /// \brief Parent entity id, kNoParent for top level entities.
+      unsigned int parent{kNoParent};
+
+      /// \brief Ids of registered child entities.
+      std::vector<unsigned int> children;
+    };
+
+    /// \brief Value returned by SlotIndex for unknown entities.
+    public: static constexpr std::size_t kInvalidSlot =
+        std::numeric_limits<std::size_t>::max();
+
+    /// \brief Parent id of top level entities.
+    public: static constexpr unsigned int kNoParent =
+        std::numeric_limits<unsigned int>::max();
+
+    /// \brief Add an entity, or replace the existing entity with the same
+    /// id.
+    /// \param[in] _id Entity id.
+    /// \param[in] _type Kind of rendering object.
+    /// \param[in] _node Rendering node mirroring the entity.
+    /// \param[in] _parent Id of the parent entity, kNoParent for top level
+    /// entities. Unknown parents are treated as kNoParent.
+    public: void Add(unsigned int _id, EntityType _type,
+                     const std::shared_ptr<NodeT> &_node,
+                     unsigned int _parent = kNoParent)
+    {
+      if (_parent == _id || !this->Contains(_parent))
+        _parent = kNoParent;
+
+      auto it = this->index.find(_id);
+      if (it != this->index.end())
+      {
+        this->Detach(_id);
+        Slot &slot = this->slots[it->second];
+        slot.type = _type;
+        slot.node = _node;
+        slot.localPose = math::Pose3d::Zero;
+        slot.hasAppliedPose = false;
+        slot.parent = _parent;
+      }
+      else
+      {
+        Slot slot;
+        slot.id = _id;
+        slot.type = _type;
+        slot.node = _node;
+        slot.parent = _parent;
+        this->index.emplace(_id, this->slots.size());
+        this->slots.push_back(std::move(slot));
+      }
+
+      if (_parent != kNoParent)
+        this->Find(_parent)->children.push_back(_id);
+    }
+
+    /// \brief Remove an entity. Its children stay registered, as top level
+    /// entities.
+    /// \param[in] _id Entity id.
+    /// \return True if the entity was registered.
+    public: bool Remove(unsigned int _id)
+    {
+      auto it = this->index.find(_id);
+      if (it == this->index.end())
+        return false;
+
+      this->Detach(_id);
+      for (const unsigned int child : this->slots[it->second].children)
+        this->slots[this->index.at(child)].parent = kNoParent;
+
+      const std::size_t removed = it->second;
+      const std::size_t last = this->slots.size() - 1;
+      this->index.erase(it);
+
+      if (this->slots[removed].staged)
+      {
+        this->staged.erase(std::remove(this->staged.begin(),
+            this->staged.end(), removed), this->staged.end());
+      }
+
+      if (removed != last)
+      {
+        this->slots[removed] = std::move(this->slots[last]);
+        this->index[this->slots[removed].id] = removed;
+        if (this->slots[removed].staged)
+        {
+          std::replace(this->staged.begin(), this->staged.end(), last,
+              removed);
+        }
+      }
+      this->slots.pop_back();
+      return true;
+    }
+
+    /// \brief Remove an entity and all its descendants in one pass.
+    /// \param[in] _id Id of the root entity.
+    /// \param[in] _fn Callback invoked as `void(const Slot &)` for each
+    /// removed entity, root first, before it's removed.
+    /// \return Number of entities removed.
+    public: template <typename RemoveFn>
+            std::size_t RemoveSubtree(unsigned int _id, RemoveFn &&_fn)
+    {
+      if (!this->Contains(_id))
+        return 0u;
+
+      std::size_t removed{0u};
+      this->subtree.clear();
+      this->subtree.push_back(_id);
+      while (!this->subtree.empty())
+      {
+        const unsigned int id = this->subtree.back();
+        this->subtree.pop_back();
+
+        const Slot *slot = this->Find(id);
+        if (nullptr == slot)
+          continue;
+        _fn(*slot);
+        this->subtree.insert(this->subtree.end(), slot->children.begin(),
+            slot->children.end());
+
+        // Descendants don't need detaching from their parent, which is
+        // removed too
+        if (id != _id)
+          this->Find(id)->parent = kNoParent;
+        this->Find(id)->children.clear();
+        this->Remove(id);
+        ++removed;
+      }
+      return removed;
+    }
+
+    /// \brief Get the slot index of an entity.
+    /// \param[in] _id Entity id.
+    /// \return Slot index, or kInvalidSlot if the entity is unknown.
+    public: std::size_t SlotIndex(unsigned int _id) const
+    {
+      auto it = this->index.find(_id);
+      return it == this->index.end() ? kInvalidSlot : it->second;
+    }
+
+    /// \brief Get an entity's slot.
+    /// \param[in] _id Entity id.
+    /// \return Pointer to the slot, or null if the entity is unknown.
+    public: Slot *Find(unsigned int _id)
+    {
+      auto it = this->index.find(_id);
+      return it == this->index.end() ? nullptr : &this->slots[it->second];
+    }
+
+    /// \brief Get an entity's slot.
+    /// \param[in] _id Entity id.
+    /// \return Pointer to the slot, or null if the entity is unknown.
+    public: const Slot *Find(unsigned int _id) const
+    {
+      auto it = this->index.find(_id);
+      return it == this->index.end() ? nullptr : &this->slots[it->second];
+    }
+
+    /// \brief Check whether an entity is registered.
+    /// \param[in] _id Entity id.
+    /// \return True if registered.
+    public: bool Contains(unsigned int _id) const
+    {
+      return this->index.find(_id) != this->index.end();
+    }
+
+    /// \brief Set the additional local pose of an entity.
+    /// \param[in] _id Entity id.
+    /// \param[in] _localPose Local pose applied after every incoming pose.
+    /// \return True if the entity is registered.
+    public: bool SetLocalPose(unsigned int _id,
+                              const math::Pose3d &_localPose)
+    {
+      Slot *slot = this->Find(_id);
+      if (nullptr == slot)
+        return false;
+      slot->localPose = _localPose;
+      return true;
+    }
+
+    /// \brief Stage a pose to be applied on the next sweep. Staging the
+    /// same entity again before the sweep overwrites the previous pose.
+    /// \param[in] _id Entity id.
+    /// \param[in] _pose New pose.
+    /// \return True if the entity is registered.
+    public: bool StagePose(unsigned int _id, const math::Pose3d &_pose)
+    {
+      auto it = this->index.find(_id);
+      if (it == this->index.end())
+        return false;
+
+      Slot &slot = this->slots[it->second];
+      slot.pose = _pose * slot.localPose;
+      if (!slot.staged)
+      {
+        slot.staged = true;
+        this->staged.push_back(it->second);
+      }
+      return true;
+    }
+
+    /// \brief Set how much a staged pose must differ from the last pose
+    /// applied to the same entity to be applied. Poses within both
+    /// tolerances are skipped.
+    /// \param[in] _linear Position tolerance, in meters.
+    /// \param[in] _angular Rotation tolerance, in radians.
+    public: void SetPoseTolerance(double _linear, double _angular)
+    {
+      this->linearTolerance = std::max(_linear, 0.0);
+      this->minRotationDot = std::cos(std::max(_angular, 0.0) / 2.0);
+    }
+
+    /// \brief Whether a pose is within tolerance of another.
+    /// \param[in] _a First pose.
+    /// \param[in] _b Second pose.
+    /// \return True if the difference can be ignored.
+    public: bool SamePose(const math::Pose3d &_a,
+                          const math::Pose3d &_b) const
+    {
+      if (_a.Pos().Distance(_b.Pos()) > this->linearTolerance)
+        return false;
+
+      const auto &qa = _a.Rot();
+      const auto &qb = _b.Rot();
+      if (qa.W() == qb.W() && qa.X() == qb.X() && qa.Y() == qb.Y() &&
+          qa.Z() == qb.Z())
+      {
+        return true;
+      }
+
+      // Half the rotation angle between both is acos(|a.b|)
+      return std::abs(qa.Dot(qb)) >= this->minRotationDot;
+    }
+
+    /// \brief Apply all staged poses and clear the staged list. Poses
+    /// within tolerance of the last pose applied to the same entity are
+    /// skipped. Entities whose node has expired are removed from the
+    /// registry, together with their descendants.
+    /// \param[in] _apply Callback invoked as `bool(NodeT &, const Slot &)`
+    /// for each staged slot whose node is alive. Return false to skip
+    /// counting the slot as applied.
+    /// \return Number of poses applied.
+    public: template <typename ApplyFn>
+            std::size_t ApplyStagedPoses(ApplyFn &&_apply)
+    {
+      return this->ApplyStagedPoses(std::forward<ApplyFn>(_apply),
+          [](const Slot &) {});
+    }
+
+    /// \brief Apply all staged poses and clear the staged list, like the
+    /// overload above, and let the caller clean up after the entities
+    /// removed because their node expired.
+    /// \param[in] _apply Callback invoked as `bool(NodeT &, const Slot &)`
+    /// for each staged slot whose node is alive.
+    /// \param[in] _remove Callback invoked as `void(const Slot &)` for each
+    /// removed entity, as in RemoveSubtree.
+    /// \return Number of poses applied.
+    public: template <typename ApplyFn, typename RemoveFn>
+            std::size_t ApplyStagedPoses(ApplyFn &&_apply, RemoveFn &&_remove)
+    {
+      std::size_t applied{0u};
+      for (const std::size_t i : this->staged)
+      {
+        Slot &slot = this->slots[i];
+        slot.staged = false;
+        if (slot.hasAppliedPose && this->SamePose(slot.pose, slot.appliedPose))
+        {
+          ++this->skippedPoses;
+          continue;
+        }
+
+        if (auto node = slot.node.lock())
+        {
+          if (_apply(*node, static_cast<const Slot &>(slot)))
+          {
+            slot.appliedPose = slot.pose;
+            slot.hasAppliedPose = true;
+            ++applied;
+          }
+        }
+        else
+        {
+          this->expired.push_back(slot.id);
+        }
+      }
+      this->staged.clear();
+
+      for (const unsigned int id : this->expired)
+        this->RemoveSubtree(id, _remove);
+      this->expired.clear();
+
+      this->appliedPoses += applied;
+      return applied;
+    }
+
+    /// \brief Total number of staged poses applied.
+    /// \return Number of poses applied.
+    public: std::uint64_t AppliedPoseCount() const
+    {
+      return this->appliedPoses;
+    }
+
+    /// \brief Total number of staged poses skipped because they didn't
+    /// change enough.
+    /// \return Number of poses skipped.
+    public: std::uint64_t SkippedPoseCount() const
+    {
+      return this->skippedPoses;
+    }
+
+    /// \brief Invoke a callback for every registered entity.
+    /// \param[in] _fn Callback invoked as `void(const Slot &)`. It must not
+    /// add or remove entities.
+    public: template <typename Fn>
+            void ForEach(Fn &&_fn) const
+    {
+      for (const Slot &slot : this->slots)
+        _fn(slot);
+    }
+
+    /// \brief Number of registered entities.
+    /// \return Number of entities.
+    public: std::size_t Size() const
+    {
+      return this->slots.size();
+    }
+
+    /// \brief Number of staged poses waiting for the next sweep.
+    /// \return Number of staged poses.
+    public: std::size_t StagedCount() const
+    {
+      return this->staged.size();
+    }
+
+    /// \brief Remove all entities.
+    public: void Clear()
+    {
+      this->index.clear();
+      this->slots.clear();
+      this->staged.clear();
+    }
+
+    /// \brief Remove an entity from its parent's list of children.
+    /// \param[in] _id Entity id.
+    private: void Detach(unsigned int _id)
+    {
+      Slot *slot = this->Find(_id);
+      if (nullptr == slot || slot->parent == kNoParent)
+        return;
+
+      Slot *parent = this->Find(slot->parent);
+      slot->parent = kNoParent;
+      if (nullptr == parent)
+        return;
+
+      auto &siblings = parent->children;
+      auto it = std::find(siblings.begin(), siblings.end(), _id);
+      if (it != siblings.end())
+      {
+        *it = siblings.back();
+        siblings.pop_back();
+      }
+    }
+
+    /// \brief Entity id to slot index.
+    private: std::unordered_map<unsigned int, std::size_t> index;
+
+    /// \brief Dense entity storage.
+    private: std::vector<Slot> slots;
+
+    /// \brief Indices of slots with a staged pose, in staging order.
+    private: std::vector<std::size_t> staged;
+
+    /// \brief Scratch list of expired entities found during a sweep.
+    private: std::vector<unsigned int> expired;
+
+    /// \brief Scratch stack of entities left to visit in RemoveSubtree.
+    private: std::vector<unsigned int> subtree;
+
+    /// \brief Position tolerance of pose changes.
+    private: double linearTolerance{0.0};
+
+    /// \brief Minimum absolute dot product between rotations considered
+    /// the same, the cosine of half the rotation tolerance.
+    private: double minRotationDot{1.0};
+
+    /// \brief Total number of poses applied.
+    private: std::uint64_t appliedPoses{0u};
+
+    /// \brief Total number of poses skipped.
+    private: std::uint64_t skippedPoses{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_ENTITYREGISTRY_HH_
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "EntityRegistry.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Minimal stand-in for a rendering node
+struct TestNode
+{
+  /// \brief Last pose set
+  math::Pose3d pose;
+};
+
+using TestRegistry = EntityRegistry<TestNode>;
+
+/////////////////////////////////////////////////
+TEST(EntityRegistryTest, AddFindRemove)
+{
+  TestRegistry registry;
+  EXPECT_EQ(0u, registry.Size());
+  EXPECT_EQ(nullptr, registry.Find(1u));
+  EXPECT_EQ(TestRegistry::kInvalidSlot, registry.SlotIndex(1u));
+
+  auto visual = std::make_shared<TestNode>();
+  auto light = std::make_shared<TestNode>();
+  registry.Add(1u, EntityType::kVisual, visual);
+  registry.Add(2u, EntityType::kLight, light);
+  EXPECT_EQ(2u, registry.Size());
+
+  auto slot = registry.Find(2u);
+  ASSERT_NE(nullptr, slot);
+  EXPECT_EQ(2u, slot->id);
+  EXPECT_EQ(EntityType::kLight, slot->type);
+  EXPECT_EQ(light, slot->node.lock());
+
+  // Removing the first slot moves the last one into its place
+  EXPECT_TRUE(registry.Remove(1u));
+  EXPECT_FALSE(registry.Remove(1u));
+  EXPECT_FALSE(registry.Contains(1u));
+  EXPECT_EQ(0u, registry.SlotIndex(2u));
+  ASSERT_NE(nullptr, registry.Find(2u));
+  EXPECT_EQ(light, registry.Find(2u)->node.lock());
+
+  registry.Clear();
+  EXPECT_EQ(0u, registry.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityRegistryTest, ApplyStagedPoses)
+{
+  TestRegistry registry;
+  auto plane = std::make_shared<TestNode>();
+  auto box = std::make_shared<TestNode>();
+  registry.Add(10u, EntityType::kVisual, plane);
+  registry.Add(20u, EntityType::kVisual, box);
+
+  const math::Pose3d localPose(0, 0, 1, 0, 0, 0);
+  EXPECT_TRUE(registry.SetLocalPose(10u, localPose));
+  EXPECT_FALSE(registry.SetLocalPose(30u, localPose));
+
+  // Unknown entities are not staged, repeated entities are staged once
+  EXPECT_TRUE(registry.StagePose(10u, math::Pose3d(1, 0, 0, 0, 0, 0)));
+  EXPECT_TRUE(registry.StagePose(20u, math::Pose3d(1, 0, 0, 0, 0, 0)));
+  EXPECT_TRUE(registry.StagePose(20u, math::Pose3d(2, 0, 0, 0, 0, 0)));
+  EXPECT_FALSE(registry.StagePose(30u, math::Pose3d(3, 0, 0, 0, 0, 0)));
+  EXPECT_EQ(2u, registry.StagedCount());
+
+  auto apply = [](TestNode &_node, const TestRegistry::Slot &_slot)
+  {
+    _node.pose = _slot.pose;
+    return true;
+  };
+  EXPECT_EQ(2u, registry.ApplyStagedPoses(apply));
+  EXPECT_EQ(0u, registry.StagedCount());
+  EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0) * localPose, plane->pose);
+  EXPECT_EQ(math::Pose3d(2, 0, 0, 0, 0, 0), box->pose);
+
+  // Nothing staged, nothing applied
+  EXPECT_EQ(0u, registry.ApplyStagedPoses(apply));
+}
+
+/////////////////////////////////////////////////
+TEST(EntityRegistryTest, UnchangedPoses)
+{
+  TestRegistry registry;
+  auto node = std::make_shared<TestNode>();
+  registry.Add(1u, EntityType::kVisual, node);
+
+  unsigned int calls{0u};
+  auto apply = [&calls](TestNode &_node, const TestRegistry::Slot &_slot)
+  {
+    _node.pose = _slot.pose;
+    ++calls;
+    return true;
+  };
+
+  // The first pose is always applied, identical ones are skipped
+  const math::Pose3d pose(1, 2, 3, 0, 0, 0.5);
+  EXPECT_TRUE(registry.StagePose(1u, pose));
+  EXPECT_EQ(1u, registry.ApplyStagedPoses(apply));
+  EXPECT_TRUE(registry.StagePose(1u, pose));
+  EXPECT_EQ(0u, registry.ApplyStagedPoses(apply));
+  EXPECT_EQ(1u, calls);
+  EXPECT_EQ(1u, registry.AppliedPoseCount());
+  EXPECT_EQ(1u, registry.SkippedPoseCount());
+
+  // Without tolerance any change is applied
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 2, 3.0001, 0, 0, 0.5)));
+  EXPECT_EQ(1u, registry.ApplyStagedPoses(apply));
+
+  // Changes within tolerance are skipped, and compared against the last
+  // applied pose so slow motion still gets applied eventually
+  registry.SetPoseTolerance(0.01, 0.01);
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 2, 3.006, 0, 0, 0.5)));
+  EXPECT_EQ(0u, registry.ApplyStagedPoses(apply));
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 2, 3.012, 0, 0, 0.5)));
+  EXPECT_EQ(1u, registry.ApplyStagedPoses(apply));
+  EXPECT_EQ(math::Pose3d(1, 2, 3.012, 0, 0, 0.5), node->pose);
+
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 2, 3.012, 0, 0, 0.505)));
+  EXPECT_EQ(0u, registry.ApplyStagedPoses(apply));
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 2, 3.012, 0, 0, 0.52)));
+  EXPECT_EQ(1u, registry.ApplyStagedPoses(apply));
+
+  EXPECT_EQ(4u, calls);
+  EXPECT_EQ(4u, registry.AppliedPoseCount());
+  EXPECT_EQ(3u, registry.SkippedPoseCount());
+
+  // A replaced entity gets its first pose applied
+  auto other = std::make_shared<TestNode>();
+  registry.Add(1u, EntityType::kVisual, other);
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 2, 3.012, 0, 0, 0.52)));
+  EXPECT_EQ(1u, registry.ApplyStagedPoses(apply));
+  EXPECT_EQ(math::Pose3d(1, 2, 3.012, 0, 0, 0.52), other->pose);
+}
+
+/////////////////////////////////////////////////
+TEST(EntityRegistryTest, RemoveWhileStaged)
+{
+  TestRegistry registry;
+  std::vector<std::shared_ptr<TestNode>> nodes;
+  for (unsigned int id = 0u; id < 4u; ++id)
+  {
+    nodes.push_back(std::make_shared<TestNode>());
+    registry.Add(id, EntityType::kVisual, nodes.back());
+    EXPECT_TRUE(registry.StagePose(id,
+        math::Pose3d(id, 0, 0, 0, 0, 0)));
+  }
+
+  // Removing a staged entity keeps the staged list consistent with the
+  // slot that was moved into its place
+  EXPECT_TRUE(registry.Remove(1u));
+  EXPECT_EQ(3u, registry.StagedCount());
+
+  EXPECT_EQ(3u, registry.ApplyStagedPoses(
+      [](TestNode &_node, const TestRegistry::Slot &_slot)
+      {
+        _node.pose = _slot.pose;
+        return true;
+      }));
+  EXPECT_EQ(math::Pose3d::Zero, nodes[1]->pose);
+  EXPECT_EQ(math::Pose3d(3, 0, 0, 0, 0, 0), nodes[3]->pose);
+}
+
+/////////////////////////////////////////////////
+TEST(EntityRegistryTest, ExpiredNodes)
+{
+  TestRegistry registry;
+  auto alive = std::make_shared<TestNode>();
+  registry.Add(1u, EntityType::kVisual, alive);
+  {
+    auto destroyed = std::make_shared<TestNode>();
+    registry.Add(2u, EntityType::kLight, destroyed);
+  }
+
+  EXPECT_TRUE(registry.StagePose(1u, math::Pose3d(1, 0, 0, 0, 0, 0)));
+  EXPECT_TRUE(registry.StagePose(2u, math::Pose3d(1, 0, 0, 0, 0, 0)));
+
+  // Entities whose node is gone are dropped during the sweep
+  EXPECT_EQ(1u, registry.ApplyStagedPoses(
+      [](TestNode &, const TestRegistry::Slot &)
+      {
+        return true;
+      }));
+  EXPECT_TRUE(registry.Contains(1u));
+  EXPECT_FALSE(registry.Contains(2u));
+  EXPECT_EQ(1u, registry.Size());
+
+  // Their descendants go with them, and the caller is told about each
+  auto child = std::make_shared<TestNode>();
+  {
+    auto destroyed = std::make_shared<TestNode>();
+    registry.Add(3u, EntityType::kVisual, destroyed);
+    registry.Add(4u, EntityType::kVisual, child, 3u);
+  }
+  EXPECT_TRUE(registry.StagePose(3u, math::Pose3d(1, 0, 0, 0, 0, 0)));
+
+  std::vector<unsigned int> removed;
+  EXPECT_EQ(0u, registry.ApplyStagedPoses(
+      [](TestNode &, const TestRegistry::Slot &)
+      {
+        return true;
+      },
+      [&removed](const TestRegistry::Slot &_slot)
+      {
+        removed.push_back(_slot.id);
+      }));
+  EXPECT_EQ((std::vector<unsigned int>{3u, 4u}), removed);
+  EXPECT_FALSE(registry.Contains(4u));
+  EXPECT_EQ(1u, registry.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityRegistryTest, RemoveSubtree)
+{
+  TestRegistry registry;
+  std::vector<std::shared_ptr<TestNode>> nodes;
+  auto add = [&](unsigned int _id, unsigned int _parent)
+  {
+    nodes.push_back(std::make_shared<TestNode>());
+    registry.Add(_id, EntityType::kVisual, nodes.back(), _parent);
+  };
+
+  // 1 -> {2 -> {3, 4}, 5}, 6 -> {7}
+  add(1u, TestRegistry::kNoParent);
+  add(2u, 1u);
+  add(3u, 2u);
+  add(4u, 2u);
+  add(5u, 1u);
+  add(6u, TestRegistry::kNoParent);
+  add(7u, 6u);
+  EXPECT_EQ(7u, registry.Size());
+  ASSERT_NE(nullptr, registry.Find(1u));
+  EXPECT_EQ(2u, registry.Find(1u)->children.size());
+  EXPECT_EQ(1u, registry.Find(2u)->parent);
+
+  // Unknown parents make top level entities
+  add(8u, 100u);
+  EXPECT_EQ(TestRegistry::kNoParent, registry.Find(8u)->parent);
+
+  EXPECT_TRUE(registry.StagePose(4u, math::Pose3d::Zero));
+  EXPECT_TRUE(registry.StagePose(7u, math::Pose3d::Zero));
+
+  std::vector<unsigned int> removed;
+  EXPECT_EQ(3u, registry.RemoveSubtree(2u,
+      [&removed](const TestRegistry::Slot &_slot)
+      {
+        removed.push_back(_slot.id);
+      }));
+  ASSERT_EQ(3u, removed.size());
+  EXPECT_EQ(2u, removed[0]);
+  EXPECT_FALSE(registry.Contains(3u));
+  EXPECT_FALSE(registry.Contains(4u));
+  EXPECT_EQ(1u, registry.StagedCount());
+
+  // The parent no longer lists the subtree
+  ASSERT_EQ(1u, registry.Find(1u)->children.size());
+  EXPECT_EQ(5u, registry.Find(1u)->children[0]);
+
+  EXPECT_EQ(2u, registry.RemoveSubtree(1u, [](const TestRegistry::Slot &) {}));
+  EXPECT_EQ(0u, registry.RemoveSubtree(1u, [](const TestRegistry::Slot &) {}));
+  EXPECT_EQ(3u, registry.Size());
+
+  unsigned int topLevel{0u};
+  registry.ForEach([&topLevel](const TestRegistry::Slot &_slot)
+  {
+    if (_slot.parent == TestRegistry::kNoParent)
+      ++topLevel;
+  });
+  EXPECT_EQ(2u, topLevel);
+
+  // Removing a single entity keeps its children as top level entities
+  EXPECT_TRUE(registry.Remove(6u));
+  ASSERT_NE(nullptr, registry.Find(7u));
+  EXPECT_EQ(TestRegistry::kNoParent, registry.Find(7u)->parent);
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_LAZYMODELS_HH_
+#define GZ_GUI_PLUGINS_LAZYMODELS_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Models which are only fully built while they're close to the
+  /// camera.
+  ///
+  /// Each model is registered with a bounding sphere radius around its
+  /// origin and starts collapsed. A model is expanded once its bounding
+  /// sphere comes within the load distance of the camera, and collapsed
+  /// again once it's further than the unload distance, which is larger so
+  /// models at the boundary don't flip on every frame.
+  ///
+  /// Every expansion gets a new generation number, so work queued for an
+  /// expansion can tell if the model was collapsed in the meantime.
+  ///
+  /// \tparam DataT Data needed to expand a model, e.g. its msg.
+  template <typename DataT>
+  class LazyModels
+  {
+    /// \brief Set the distances at which models are expanded and
+    /// collapsed.
+    /// \param[in] _load Distance from the camera to a model's bounding
+    /// sphere below which it's expanded.
+    /// \param[in] _unload Distance above which it's collapsed. Clamped to be
+    /// at least the load distance.
+    public: void SetDistances(double _load, double _unload)
+    {
+      this->loadDistance = std::max(_load, 0.0);
+      this->unloadDistance = std::max(_unload, this->loadDistance);
+    }
+
+    /// \brief Get the load distance.
+    /// \return Distance below which models are expanded.
+    public: double LoadDistance() const
+    {
+      return this->loadDistance;
+    }
+
+    /// \brief Get the unload distance.
+    /// \return Distance above which models are collapsed.
+    public: double UnloadDistance() const
+    {
+      return this->unloadDistance;
+    }
+
+    /// \brief Register a collapsed model, replacing any model with the
+    /// same id.
+    /// \param[in] _id Model entity id.
+    /// \param[in] _radius Bounding sphere radius around the model origin.
+    /// \param[in] _data Data needed to expand the model.
+    public: void Add(unsigned int _id, double _radius, DataT _data)
+    {
+      auto [it, inserted] = this->index.try_emplace(_id,
+          this->models.size());
+      if (inserted)
+        this->models.emplace_back();
+
+      Model &model = this->models[it->second];
+      if (model.expanded)
+        --this->expandedCount;
+      model.id = _id;
+      model.radius = std::max(_radius, 0.0);
+      model.expanded = false;
+      model.generation = 0u;
+      model.data = std::move(_data);
+    }
+
+    /// \brief Remove a model.
+    /// \param[in] _id Model entity id.
+    /// \return True if the model was registered.
+    public: bool Erase(unsigned int _id)
+    {
+      auto it = this->index.find(_id);
+      if (it == this->index.end())
+        return false;
+
+      const std::size_t i = it->second;
+      this->index.erase(it);
+      if (this->models[i].expanded)
+        --this->expandedCount;
+
+      // Move the last model into the hole
+      if (i + 1u != this->models.size())
+      {
+        this->models[i] = std::move(this->models.back());
+        this->index[this->models[i].id] = i;
+      }
+      this->models.pop_back();
+      return true;
+    }
+
+    /// \brief Remove all models.
+    public: void Clear()
+    {
+      this->models.clear();
+      this->index.clear();
+      this->expandedCount = 0u;
+    }
+
+    /// \brief Whether a model is registered.
+    /// \param[in] _id Model entity id.
+    /// \return True if registered.
+    public: bool Contains(unsigned int _id) const
+    {
+      return this->index.find(_id) != this->index.end();
+    }
+
+    /// \brief Get the data of a model.
+    /// \param[in] _id Model entity id.
+    /// \return Data passed to Add, null if the model isn't registered.
+    public: const DataT *Find(unsigned int _id) const
+    {
+      auto it = this->index.find(_id);
+      if (it == this->index.end())
+        return nullptr;
+      return &this->models[it->second].data;
+    }
+
+    /// \brief Whether a model is still in the expansion with the given
+    /// generation.
+    /// \param[in] _id Model entity id.
+    /// \param[in] _generation Generation passed to the expand callback.
+    /// \return True if the model is registered, expanded, and hasn't been
+    /// collapsed since that expansion.
+    public: bool IsCurrent(unsigned int _id, std::uint64_t _generation) const
+    {
+      auto it = this->index.find(_id);
+      if (it == this->index.end())
+        return false;
+      const Model &model = this->models[it->second];
+      return model.expanded && model.generation == _generation;
+    }
+
+    /// \brief Expand and collapse models based on their distance to the
+    /// camera.
+    /// \param[in] _camera Camera position in world frame.
+    /// \param[in] _position Callback invoked as
+    /// `bool(unsigned int _id, math::Vector3d &_pos)` to get the world
+    /// position of a model's origin. Models it returns false for are
+    /// skipped.
+    /// \param[in] _expand Callback invoked as
+    /// `void(unsigned int _id, const DataT &_data, std::uint64_t _gen)`
+    /// for each model to build.
+    /// \param[in] _collapse Callback invoked as
+    /// `void(unsigned int _id, const DataT &_data)` for each model to
+    /// release.
+    /// \return Number of models expanded or collapsed.
+    public: template <typename PositionFn, typename ExpandFn,
+                      typename CollapseFn>
+            std::size_t Update(const math::Vector3d &_camera,
+                               PositionFn &&_position, ExpandFn &&_expand,
+                               CollapseFn &&_collapse)
+    {
+      std::size_t changed{0u};
+      math::Vector3d pos;
+      for (Model &model : this->models)
+      {
+        if (!_position(model.id, pos))
+          continue;
+
+        const double distance = _camera.Distance(pos) - model.radius;
+        if (!model.expanded && distance <= this->loadDistance)
+        {
+          model.expanded = true;
+          model.generation = ++this->lastGeneration;
+          ++this->expandedCount;
+          ++changed;
+          _expand(model.id, static_cast<const DataT &>(model.data),
+              model.generation);
+        }
+        else if (model.expanded && distance > this->unloadDistance)
+        {
+          model.expanded = false;
+          --this->expandedCount;
+          ++changed;
+          _collapse(model.id, static_cast<const DataT &>(model.data));
+        }
+      }
+      return changed;
+    }
+
+    /// \brief Number of registered models.
+    /// \return Number of models.
+    public: std::size_t Size() const
+    {
+      return this->models.size();
+    }
+
+    /// \brief Number of expanded models.
+    /// \return Number of models.
+    public: std::size_t ExpandedCount() const
+    {
+      return this->expandedCount;
+    }
+
+    /// \brief A registered model.
+    private: struct Model
+    {
+      /// \brief Model entity id.
+      unsigned int id{0u};
+
+      /// \brief Bounding sphere radius around the model origin.
+      double radius{0.0};
+
+      /// \brief True while the model is built.
+      bool expanded{false};
+
+      /// \brief Generation of the current expansion.
+      std::uint64_t generation{0u};
+
+      /// \brief Data needed to expand the model.
+      DataT data{};
+    };
+
+    /// \brief Registered models, densely packed.
+    private: std::vector<Model> models;
+
+    /// \brief Index into models keyed by entity id.
+    private: std::unordered_map<unsigned int, std::size_t> index;
+
+    /// \brief Number of expanded models.
+    private: std::size_t expandedCount{0u};
+
+    /// \brief Last generation given to an expansion.
+    private: std::uint64_t lastGeneration{0u};
+
+    /// \brief Distance below which models are expanded.
+    private: double loadDistance{0.0};
+
+    /// \brief Distance above which models are collapsed.
+    private: double unloadDistance{0.0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_LAZYMODELS_HH_
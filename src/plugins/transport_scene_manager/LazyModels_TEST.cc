@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "LazyModels.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Lazy models together with their positions, recording callbacks
+struct TestWorld
+{
+  /// \brief Move the camera and update the models
+  /// \param[in] _x Camera position along X
+  /// \return Number of models expanded or collapsed
+  std::size_t Update(double _x)
+  {
+    return this->models.Update(math::Vector3d(_x, 0, 0),
+        [this](unsigned int _id, math::Vector3d &_pos)
+        {
+          auto it = this->positions.find(_id);
+          if (it == this->positions.end())
+            return false;
+          _pos = it->second;
+          return true;
+        },
+        [this](unsigned int _id, const std::string &_data,
+               std::uint64_t _generation)
+        {
+          this->expanded.push_back(_data);
+          this->generations[_id] = _generation;
+        },
+        [this](unsigned int, const std::string &_data)
+        {
+          this->collapsed.push_back(_data);
+        });
+  }
+
+  /// \brief Models under test
+  LazyModels<std::string> models;
+
+  /// \brief Model positions
+  std::unordered_map<unsigned int, math::Vector3d> positions;
+
+  /// \brief Generation of the last expansion of each model
+  std::unordered_map<unsigned int, std::uint64_t> generations;
+
+  /// \brief Data of expanded models, in callback order
+  std::vector<std::string> expanded;
+
+  /// \brief Data of collapsed models, in callback order
+  std::vector<std::string> collapsed;
+};
+
+/////////////////////////////////////////////////
+TEST(LazyModelsTest, Distances)
+{
+  TestWorld world;
+  world.models.SetDistances(10.0, 20.0);
+  EXPECT_DOUBLE_EQ(10.0, world.models.LoadDistance());
+  EXPECT_DOUBLE_EQ(20.0, world.models.UnloadDistance());
+
+  world.models.Add(1u, 1.0, "near");
+  world.models.Add(2u, 5.0, "far");
+  world.positions[1u] = math::Vector3d(5, 0, 0);
+  world.positions[2u] = math::Vector3d(100, 0, 0);
+  EXPECT_EQ(2u, world.models.Size());
+  EXPECT_EQ(0u, world.models.ExpandedCount());
+
+  // Only the near model is built
+  EXPECT_EQ(1u, world.Update(0.0));
+  ASSERT_EQ(1u, world.expanded.size());
+  EXPECT_EQ("near", world.expanded[0]);
+  EXPECT_EQ(1u, world.models.ExpandedCount());
+  EXPECT_TRUE(world.models.IsCurrent(1u, world.generations[1u]));
+  EXPECT_FALSE(world.models.IsCurrent(2u, 0u));
+
+  // Nothing changes while the camera doesn't move
+  EXPECT_EQ(0u, world.Update(0.0));
+
+  // The near model is only released past the unload distance, measured to
+  // the surface of its bounding sphere
+  EXPECT_EQ(0u, world.Update(26.0));
+  EXPECT_TRUE(world.collapsed.empty());
+  EXPECT_EQ(1u, world.Update(26.5));
+  ASSERT_EQ(1u, world.collapsed.size());
+  EXPECT_EQ("near", world.collapsed[0]);
+  EXPECT_EQ(0u, world.models.ExpandedCount());
+  EXPECT_FALSE(world.models.IsCurrent(1u, world.generations[1u]));
+
+  // The far model is built once its bounding sphere is within range
+  EXPECT_EQ(0u, world.Update(84.0));
+  EXPECT_EQ(1u, world.Update(85.0));
+  ASSERT_EQ(2u, world.expanded.size());
+  EXPECT_EQ("far", world.expanded[1]);
+
+  // Expanding again starts a new generation
+  const auto firstGeneration = world.generations[1u];
+  EXPECT_EQ(2u, world.Update(0.0));
+  EXPECT_EQ("far", world.collapsed.back());
+  EXPECT_NE(firstGeneration, world.generations[1u]);
+  EXPECT_FALSE(world.models.IsCurrent(1u, firstGeneration));
+  EXPECT_TRUE(world.models.IsCurrent(1u, world.generations[1u]));
+
+  // The unload distance is never below the load distance
+  world.models.SetDistances(10.0, 5.0);
+  EXPECT_DOUBLE_EQ(10.0, world.models.UnloadDistance());
+}
+
+/////////////////////////////////////////////////
+TEST(LazyModelsTest, AddErase)
+{
+  TestWorld world;
+  world.models.SetDistances(10.0, 10.0);
+  for (unsigned int id = 0u; id < 4u; ++id)
+  {
+    world.models.Add(id, 0.0, std::to_string(id));
+    world.positions[id] = math::Vector3d(id, 0, 0);
+  }
+
+  // Models without a position are skipped
+  world.positions.erase(3u);
+  EXPECT_EQ(3u, world.Update(0.0));
+  EXPECT_EQ(3u, world.models.ExpandedCount());
+
+  // Erasing moves the last model into the hole
+  EXPECT_TRUE(world.models.Erase(1u));
+  EXPECT_FALSE(world.models.Erase(1u));
+  EXPECT_FALSE(world.models.Contains(1u));
+  EXPECT_TRUE(world.models.Contains(3u));
+  EXPECT_EQ(nullptr, world.models.Find(1u));
+  ASSERT_NE(nullptr, world.models.Find(3u));
+  EXPECT_EQ("3", *world.models.Find(3u));
+  EXPECT_EQ(3u, world.models.Size());
+  EXPECT_EQ(2u, world.models.ExpandedCount());
+  EXPECT_TRUE(world.models.IsCurrent(2u, world.generations[2u]));
+
+  // Adding an existing model replaces it, collapsed
+  world.models.Add(2u, 0.0, "replaced");
+  EXPECT_EQ("replaced", *world.models.Find(2u));
+  EXPECT_EQ(1u, world.models.ExpandedCount());
+  EXPECT_FALSE(world.models.IsCurrent(2u, world.generations[2u]));
+  world.expanded.clear();
+  world.positions[3u] = math::Vector3d(3, 0, 0);
+  EXPECT_EQ(2u, world.Update(0.0));
+  EXPECT_EQ(2u, world.expanded.size());
+  EXPECT_TRUE(world.collapsed.empty());
+
+  world.models.Clear();
+  EXPECT_EQ(0u, world.models.Size());
+  EXPECT_EQ(0u, world.models.ExpandedCount());
+  EXPECT_EQ(0u, world.Update(0.0));
+}
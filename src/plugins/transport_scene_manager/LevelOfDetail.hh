@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_LEVELOFDETAIL_HH_
+#define GZ_GUI_PLUGINS_LEVELOFDETAIL_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace gz::gui::plugins
+{
+  /// \brief Picks one of several levels of detail of a visual based on how
+  /// large it appears on screen.
+  ///
+  /// Level 0 is the most detailed. Level i + 1 is used while the screen
+  /// size is below the i-th threshold. Switching only happens once the
+  /// screen size is a margin past a threshold, so visuals close to one
+  /// don't flicker between levels.
+  class LevelOfDetail
+  {
+    /// \brief Relative margin around thresholds before switching level.
+    public: static constexpr double kHysteresis{0.1};
+
+    /// \brief Constructor.
+    /// \param[in] _screenSizes Screen size below which each coarser level
+    /// is used, in decreasing order, as a fraction of the viewport height.
+    public: explicit LevelOfDetail(std::vector<double> _screenSizes = {})
+      : screenSizes(std::move(_screenSizes))
+    {
+    }
+
+    /// \brief Check if screen size thresholds are valid, positive and in
+    /// decreasing order.
+    /// \param[in] _screenSizes Thresholds.
+    /// \return True if valid.
+    public: static bool Valid(const std::vector<double> &_screenSizes)
+    {
+      for (std::size_t i = 0u; i < _screenSizes.size(); ++i)
+      {
+        if (!(_screenSizes[i] > 0.0))
+          return false;
+        if (i > 0u && _screenSizes[i] >= _screenSizes[i - 1u])
+          return false;
+      }
+      return true;
+    }
+
+    /// \brief Number of levels.
+    /// \return Number of levels, one more than the number of thresholds.
+    public: std::size_t LevelCount() const
+    {
+      return this->screenSizes.size() + 1u;
+    }
+
+    /// \brief Current level.
+    /// \return Level index, 0 being the most detailed.
+    public: std::size_t Level() const
+    {
+      return this->level;
+    }
+
+    /// \brief Update the current level.
+    /// \param[in] _screenSize Current screen size.
+    /// \return True if the level changed.
+    public: bool Update(double _screenSize)
+    {
+      // Coarsest level allowed when getting finer, and finest one allowed
+      // when getting coarser
+      std::size_t coarser{0u};
+      std::size_t finer{0u};
+      for (const double threshold : this->screenSizes)
+      {
+        if (_screenSize < threshold * (1.0 - kHysteresis))
+          ++coarser;
+        if (_screenSize < threshold * (1.0 + kHysteresis))
+          ++finer;
+      }
+
+      const std::size_t previous = this->level;
+      this->level = std::clamp(this->level, coarser, finer);
+      return this->level != previous;
+    }
+
+    /// \brief Get the size of a bounding sphere on screen.
+    /// \param[in] _radius Sphere radius.
+    /// \param[in] _distance Distance from the camera to the sphere center.
+    /// \param[in] _fovY Camera vertical field of view, in radians.
+    /// \return Sphere diameter as a fraction of the viewport height, may
+    /// exceed 1. Infinite if the camera is inside the sphere.
+    public: static double ScreenSize(double _radius, double _distance,
+                                     double _fovY)
+    {
+      if (_distance <= _radius)
+        return std::numeric_limits<double>::infinity();
+      return _radius / (_distance * std::tan(_fovY * 0.5));
+    }
+
+    /// \brief Screen size thresholds, in decreasing order.
+    private: std::vector<double> screenSizes;
+
+    /// \brief Current level.
+    private: std::size_t level{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_LEVELOFDETAIL_HH_
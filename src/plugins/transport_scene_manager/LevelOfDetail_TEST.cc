@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "LevelOfDetail.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(LevelOfDetailTest, Valid)
+{
+  EXPECT_TRUE(LevelOfDetail::Valid({}));
+  EXPECT_TRUE(LevelOfDetail::Valid({0.5, 0.1, 0.01}));
+  EXPECT_FALSE(LevelOfDetail::Valid({0.1, 0.5}));
+  EXPECT_FALSE(LevelOfDetail::Valid({0.5, 0.5}));
+  EXPECT_FALSE(LevelOfDetail::Valid({0.5, 0.0}));
+  EXPECT_FALSE(LevelOfDetail::Valid({NAN}));
+}
+
+/////////////////////////////////////////////////
+TEST(LevelOfDetailTest, Update)
+{
+  LevelOfDetail single;
+  EXPECT_EQ(1u, single.LevelCount());
+  EXPECT_FALSE(single.Update(0.0));
+  EXPECT_EQ(0u, single.Level());
+
+  LevelOfDetail lod({0.5, 0.1});
+  EXPECT_EQ(3u, lod.LevelCount());
+  EXPECT_EQ(0u, lod.Level());
+
+  // Far away, straight to the coarsest level
+  EXPECT_TRUE(lod.Update(0.01));
+  EXPECT_EQ(2u, lod.Level());
+
+  // Getting closer, only switch once clearly past the threshold
+  EXPECT_FALSE(lod.Update(0.105));
+  EXPECT_EQ(2u, lod.Level());
+  EXPECT_TRUE(lod.Update(0.12));
+  EXPECT_EQ(1u, lod.Level());
+
+  // Moving back and forth around the threshold doesn't flicker
+  EXPECT_FALSE(lod.Update(0.095));
+  EXPECT_FALSE(lod.Update(0.105));
+  EXPECT_EQ(1u, lod.Level());
+  EXPECT_TRUE(lod.Update(0.08));
+  EXPECT_EQ(2u, lod.Level());
+
+  // Up close, the most detailed level
+  EXPECT_TRUE(lod.Update(1.0));
+  EXPECT_EQ(0u, lod.Level());
+  EXPECT_FALSE(lod.Update(0.46));
+  EXPECT_TRUE(lod.Update(0.44));
+  EXPECT_EQ(1u, lod.Level());
+}
+
+/////////////////////////////////////////////////
+TEST(LevelOfDetailTest, ScreenSize)
+{
+  const double fovY = 2.0 * std::atan(1.0);
+
+  // With a 90 degree field of view the viewport spans twice the distance
+  EXPECT_NEAR(0.1, LevelOfDetail::ScreenSize(1.0, 10.0, fovY), 1e-9);
+  EXPECT_NEAR(0.01, LevelOfDetail::ScreenSize(1.0, 100.0, fovY), 1e-9);
+
+  // Inside the sphere
+  EXPECT_TRUE(std::isinf(LevelOfDetail::ScreenSize(1.0, 0.5, fovY)));
+}
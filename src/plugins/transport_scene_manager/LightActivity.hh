@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_LIGHTACTIVITY_HH_
+#define GZ_GUI_PLUGINS_LIGHTACTIVITY_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gz::gui::plugins
+{
+  /// \brief Classifies lights as static or dynamic from the history of
+  /// their pose updates.
+  ///
+  /// Lights start static. A light becomes dynamic once it has moved on
+  /// several frames without pausing for longer than the settle time, so a
+  /// light which is only placed once stays static. A dynamic light goes back
+  /// to being static after not moving for the settle time. Only dynamic
+  /// lights are visited when settling, so static lights cost nothing per
+  /// frame.
+  class LightActivity
+  {
+    /// \brief Set how many frames a light must not move for to be static
+    /// again, and how many frames it must move on to become dynamic.
+    /// \param[in] _settleFrames Frames without moving.
+    /// \param[in] _movesToDynamic Frames with a move, at least 1.
+    public: void SetThresholds(std::uint64_t _settleFrames,
+                               std::uint32_t _movesToDynamic)
+    {
+      this->settleFrames = _settleFrames;
+      this->movesToDynamic = std::max(_movesToDynamic, 1u);
+    }
+
+    /// \brief Get how many frames a light must not move for to be static
+    /// again.
+    /// \return Number of frames.
+    public: std::uint64_t SettleFrames() const
+    {
+      return this->settleFrames;
+    }
+
+    /// \brief Get how many frames a light must move on to become dynamic.
+    /// \return Number of frames.
+    public: std::uint32_t MovesToDynamic() const
+    {
+      return this->movesToDynamic;
+    }
+
+    /// \brief Start tracking a light as static, replacing any previous
+    /// light with the same id.
+    /// \param[in] _id Light entity id.
+    /// \param[in] _castShadows Whether the light was requested to cast
+    /// shadows.
+    public: void Add(unsigned int _id, bool _castShadows)
+    {
+      this->Erase(_id);
+      this->lights[_id] = {_castShadows, false, 0u, 0u};
+    }
+
+    /// \brief Stop tracking a light.
+    /// \param[in] _id Light entity id.
+    /// \return True if the light was tracked.
+    public: bool Erase(unsigned int _id)
+    {
+      auto it = this->lights.find(_id);
+      if (it == this->lights.end())
+        return false;
+
+      if (it->second.dynamic)
+      {
+        auto dyn = std::find(this->dynamicIds.begin(),
+            this->dynamicIds.end(), _id);
+        *dyn = this->dynamicIds.back();
+        this->dynamicIds.pop_back();
+      }
+      this->lights.erase(it);
+      return true;
+    }
+
+    /// \brief Stop tracking all lights.
+    public: void Clear()
+    {
+      this->lights.clear();
+      this->dynamicIds.clear();
+    }
+
+    /// \brief Record that a light moved.
+    /// \param[in] _id Light entity id.
+    /// \param[in] _frame Current frame number.
+    /// \return True if the light became dynamic.
+    public: bool Moved(unsigned int _id, std::uint64_t _frame)
+    {
+      auto it = this->lights.find(_id);
+      if (it == this->lights.end())
+        return false;
+
+      Entry &entry = it->second;
+      if (entry.moves > 0u && _frame - entry.lastMoved > this->settleFrames)
+        entry.moves = 0u;
+      if (entry.moves == 0u || entry.lastMoved != _frame)
+        ++entry.moves;
+      entry.lastMoved = _frame;
+
+      if (entry.dynamic || entry.moves < this->movesToDynamic)
+        return false;
+
+      entry.dynamic = true;
+      this->dynamicIds.push_back(_id);
+      return true;
+    }
+
+    /// \brief Turn dynamic lights which haven't moved for the settle time
+    /// back into static lights.
+    /// \param[in] _frame Current frame number.
+    /// \param[in] _onStatic Callback invoked as
+    /// `void(unsigned int _id, bool _castShadows)` for each light which
+    /// became static.
+    public: template <typename Fn>
+            void Settle(std::uint64_t _frame, Fn &&_onStatic)
+    {
+      for (std::size_t i = 0u; i < this->dynamicIds.size();)
+      {
+        const unsigned int id = this->dynamicIds[i];
+        Entry &entry = this->lights[id];
+        if (_frame - entry.lastMoved <= this->settleFrames)
+        {
+          ++i;
+          continue;
+        }
+
+        entry.dynamic = false;
+        entry.moves = 0u;
+        this->dynamicIds[i] = this->dynamicIds.back();
+        this->dynamicIds.pop_back();
+        _onStatic(id, entry.castShadows);
+      }
+    }
+
+    /// \brief Whether a light is dynamic.
+    /// \param[in] _id Light entity id.
+    /// \return True if the light is tracked and dynamic.
+    public: bool IsDynamic(unsigned int _id) const
+    {
+      auto it = this->lights.find(_id);
+      return it != this->lights.end() && it->second.dynamic;
+    }
+
+    /// \brief Number of dynamic lights.
+    /// \return Number of lights.
+    public: std::size_t DynamicCount() const
+    {
+      return this->dynamicIds.size();
+    }
+
+    /// \brief Number of tracked lights.
+    /// \return Number of lights.
+    public: std::size_t Size() const
+    {
+      return this->lights.size();
+    }
+
+    /// \brief State of a light.
+    private: struct Entry
+    {
+      /// \brief Whether the light was requested to cast shadows.
+      bool castShadows{false};
+
+      /// \brief Whether the light is dynamic.
+      bool dynamic{false};
+
+      /// \brief Number of frames with a move since the light last settled.
+      std::uint32_t moves{0u};
+
+      /// \brief Frame the light last moved on.
+      std::uint64_t lastMoved{0u};
+    };
+
+    /// \brief Tracked lights, keyed by entity id.
+    private: std::unordered_map<unsigned int, Entry> lights;
+
+    /// \brief Ids of the dynamic lights.
+    private: std::vector<unsigned int> dynamicIds;
+
+    /// \brief Frames without moving before a light is static again.
+    private: std::uint64_t settleFrames{60u};
+
+    /// \brief Frames with a move before a light becomes dynamic.
+    private: std::uint32_t movesToDynamic{3u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_LIGHTACTIVITY_HH_
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "LightActivity.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(LightActivityTest, Classify)
+{
+  LightActivity activity;
+  EXPECT_EQ(60u, activity.SettleFrames());
+  EXPECT_EQ(3u, activity.MovesToDynamic());
+  activity.SetThresholds(10u, 3u);
+  EXPECT_EQ(10u, activity.SettleFrames());
+  activity.Add(1u, true);
+  activity.Add(2u, false);
+  EXPECT_EQ(2u, activity.Size());
+  EXPECT_FALSE(activity.Moved(5u, 0u));
+
+  // A single move doesn't make a light dynamic
+  EXPECT_FALSE(activity.Moved(1u, 1u));
+  EXPECT_FALSE(activity.IsDynamic(1u));
+
+  // Moves separated by more than the settle time start over
+  EXPECT_FALSE(activity.Moved(1u, 20u));
+  EXPECT_FALSE(activity.Moved(1u, 21u));
+  EXPECT_TRUE(activity.Moved(1u, 22u));
+  EXPECT_TRUE(activity.IsDynamic(1u));
+  EXPECT_FALSE(activity.Moved(1u, 23u));
+  EXPECT_EQ(1u, activity.DynamicCount());
+
+  // Several moves on the same frame count once
+  EXPECT_FALSE(activity.Moved(2u, 23u));
+  EXPECT_FALSE(activity.Moved(2u, 23u));
+  EXPECT_FALSE(activity.Moved(2u, 23u));
+  EXPECT_FALSE(activity.IsDynamic(2u));
+
+  std::vector<std::pair<unsigned int, bool>> settled;
+  auto onStatic = [&settled](unsigned int _id, bool _castShadows)
+  {
+    settled.emplace_back(_id, _castShadows);
+  };
+
+  activity.Settle(33u, onStatic);
+  EXPECT_TRUE(settled.empty());
+  activity.Settle(34u, onStatic);
+  ASSERT_EQ(1u, settled.size());
+  EXPECT_EQ(1u, settled[0].first);
+  EXPECT_TRUE(settled[0].second);
+  EXPECT_FALSE(activity.IsDynamic(1u));
+  EXPECT_EQ(0u, activity.DynamicCount());
+}
+
+/////////////////////////////////////////////////
+TEST(LightActivityTest, Erase)
+{
+  LightActivity activity;
+  activity.SetThresholds(10u, 0u);
+  EXPECT_EQ(1u, activity.MovesToDynamic());
+  activity.Add(1u, true);
+  activity.Add(2u, true);
+  EXPECT_TRUE(activity.Moved(1u, 1u));
+  EXPECT_TRUE(activity.Moved(2u, 1u));
+  EXPECT_EQ(2u, activity.DynamicCount());
+
+  EXPECT_TRUE(activity.Erase(1u));
+  EXPECT_FALSE(activity.Erase(1u));
+  EXPECT_EQ(1u, activity.DynamicCount());
+  EXPECT_TRUE(activity.IsDynamic(2u));
+
+  // Replacing a light starts it over as static
+  activity.Add(2u, false);
+  EXPECT_EQ(0u, activity.DynamicCount());
+  EXPECT_FALSE(activity.IsDynamic(2u));
+
+  activity.Clear();
+  EXPECT_EQ(0u, activity.Size());
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MATERIALCACHE_HH_
+#define GZ_GUI_PLUGINS_MATERIALCACHE_HH_
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace gz::gui::plugins
+{
+  /// \brief Reference counted set of materials shared between visuals,
+  /// keyed by the contents they were created from.
+  ///
+  /// Users are identified by an id such as the rendering visual id, and may
+  /// hold several references, e.g. one per level of detail. A material is
+  /// handed to a release callback once its last reference is released.
+  ///
+  /// \tparam MaterialPtrT Shared material handle, e.g.
+  /// `rendering::MaterialPtr`.
+  template <typename MaterialPtrT>
+  class MaterialCache
+  {
+    /// \brief Get the material for a key, creating it if no user holds it,
+    /// and add a reference for a user.
+    /// \param[in] _key Contents the material is created from.
+    /// \param[in] _user User id.
+    /// \param[in] _create Callback invoked as `MaterialPtrT()` to create
+    /// the material on a cache miss.
+    /// \return The shared material. Null if creation failed, in which case
+    /// nothing is cached.
+    public: template <typename CreateFn>
+            MaterialPtrT Acquire(const std::string &_key, unsigned int _user,
+                                 CreateFn &&_create)
+    {
+      auto it = this->materials.find(_key);
+      if (it == this->materials.end())
+      {
+        MaterialPtrT material = _create();
+        if (!material)
+          return material;
+        it = this->materials.emplace(_key, Entry{material, 0u}).first;
+        ++this->misses;
+      }
+      else
+      {
+        ++this->hits;
+      }
+
+      ++it->second.refCount;
+      this->users.emplace(_user, &*it);
+      return it->second.material;
+    }
+
+    /// \brief Release all references held by a user.
+    /// \param[in] _user User id.
+    /// \param[in] _release Callback invoked as `void(MaterialPtrT)` for
+    /// each material which lost its last reference.
+    /// \return True if the user held any material.
+    public: template <typename ReleaseFn>
+            bool Release(unsigned int _user, ReleaseFn &&_release)
+    {
+      auto [begin, end] = this->users.equal_range(_user);
+      if (begin == end)
+        return false;
+
+      for (auto userIt = begin; userIt != end; ++userIt)
+      {
+        auto *cached = userIt->second;
+        if (--cached->second.refCount == 0u)
+        {
+          MaterialPtrT material = std::move(cached->second.material);
+          this->materials.erase(this->materials.find(cached->first));
+          _release(std::move(material));
+        }
+      }
+      this->users.erase(begin, end);
+      return true;
+    }
+
+    /// \brief Release every material, regardless of its users.
+    /// \param[in] _release Callback invoked as `void(MaterialPtrT)` for
+    /// each material.
+    public: template <typename ReleaseFn>
+            void Clear(ReleaseFn &&_release)
+    {
+      for (auto &entry : this->materials)
+        _release(std::move(entry.second.material));
+      this->materials.clear();
+      this->users.clear();
+    }
+
+    /// \brief Number of distinct materials.
+    /// \return Number of materials.
+    public: std::size_t Size() const
+    {
+      return this->materials.size();
+    }
+
+    /// \brief Number of references to the material for a key.
+    /// \param[in] _key Material contents.
+    /// \return Reference count, zero if not cached.
+    public: std::size_t RefCount(const std::string &_key) const
+    {
+      auto it = this->materials.find(_key);
+      return it == this->materials.end() ? 0u : it->second.refCount;
+    }
+
+    /// \brief Number of Acquire calls which reused a cached material.
+    /// \return Number of hits.
+    public: std::size_t Hits() const
+    {
+      return this->hits;
+    }
+
+    /// \brief Number of Acquire calls which created a material.
+    /// \return Number of misses.
+    public: std::size_t Misses() const
+    {
+      return this->misses;
+    }
+
+    /// \brief A cached material.
+    private: struct Entry
+    {
+      /// \brief The shared material.
+      MaterialPtrT material;
+
+      /// \brief Number of users.
+      std::size_t refCount;
+    };
+
+    /// \brief Materials keyed by contents.
+    private: std::unordered_map<std::string, Entry> materials;
+
+    /// \brief Materials referenced by each user. Elements of an
+    /// unordered_map don't move on rehash, and are only erased once nothing
+    /// refers to them.
+    private: std::unordered_multimap<unsigned int,
+        std::pair<const std::string, Entry> *> users;
+
+    /// \brief Number of cache hits.
+    private: std::size_t hits{0u};
+
+    /// \brief Number of cache misses.
+    private: std::size_t misses{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MATERIALCACHE_HH_
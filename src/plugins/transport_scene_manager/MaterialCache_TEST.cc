@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MaterialCache.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Stand-in for a rendering material
+struct TestMaterial
+{
+  std::string name;
+};
+
+using TestMaterialPtr = std::shared_ptr<TestMaterial>;
+
+/////////////////////////////////////////////////
+TEST(MaterialCacheTest, Share)
+{
+  MaterialCache<TestMaterialPtr> cache;
+  int created{0};
+  std::vector<std::string> released;
+
+  auto create = [&created](const std::string &_name)
+  {
+    return [&created, _name]()
+    {
+      ++created;
+      return std::make_shared<TestMaterial>(TestMaterial{_name});
+    };
+  };
+  auto release = [&released](TestMaterialPtr _material)
+  {
+    released.push_back(_material->name);
+  };
+
+  // Many users of the same contents share one material
+  auto red = cache.Acquire("red", 1u, create("red"));
+  for (unsigned int user = 2u; user <= 100u; ++user)
+    EXPECT_EQ(red, cache.Acquire("red", user, create("red")));
+  auto blue = cache.Acquire("blue", 101u, create("blue"));
+  EXPECT_NE(red, blue);
+
+  EXPECT_EQ(2, created);
+  EXPECT_EQ(2u, cache.Size());
+  EXPECT_EQ(100u, cache.RefCount("red"));
+  EXPECT_EQ(1u, cache.RefCount("blue"));
+  EXPECT_EQ(99u, cache.Hits());
+  EXPECT_EQ(2u, cache.Misses());
+
+  // Released once the last user is gone
+  for (unsigned int user = 1u; user < 100u; ++user)
+    EXPECT_TRUE(cache.Release(user, release));
+  EXPECT_FALSE(cache.Release(1u, release));
+  EXPECT_TRUE(released.empty());
+  EXPECT_TRUE(cache.Release(100u, release));
+  ASSERT_EQ(1u, released.size());
+  EXPECT_EQ("red", released[0]);
+  EXPECT_EQ(0u, cache.RefCount("red"));
+
+  // A user may hold several materials, e.g. one per level, and they're
+  // released together
+  cache.Acquire("green", 101u, create("green"));
+  cache.Acquire("green", 102u, create("green"));
+  EXPECT_EQ(2u, cache.Size());
+  EXPECT_TRUE(cache.Release(101u, release));
+  ASSERT_EQ(2u, released.size());
+  EXPECT_EQ("blue", released[1]);
+  EXPECT_EQ(1u, cache.RefCount("green"));
+
+  // Recreated after being released
+  cache.Acquire("red", 1u, create("red"));
+  EXPECT_EQ(4, created);
+
+  cache.Clear(release);
+  EXPECT_EQ(4u, released.size());
+  EXPECT_EQ(0u, cache.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(MaterialCacheTest, CreateFails)
+{
+  MaterialCache<TestMaterialPtr> cache;
+  auto release = [](TestMaterialPtr) {};
+
+  auto material = cache.Acquire("bad", 1u,
+      []() { return TestMaterialPtr(); });
+  EXPECT_EQ(nullptr, material);
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_FALSE(cache.Release(1u, release));
+}
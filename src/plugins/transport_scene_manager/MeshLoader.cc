@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <gz/common/ColladaLoader.hh>
+#include <gz/common/Console.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/OBJLoader.hh>
+#include <gz/common/STLLoader.hh>
+#include <gz/common/StringUtils.hh>
+#include <gz/common/SystemPaths.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/WorkerPool.hh>
+
+#include "MeshLoader.hh"
+
+namespace gz::gui::plugins
+{
+/// \brief Mesh formats decoded on worker threads
+enum class MeshFormat
+{
+  /// \brief Left to common::MeshManager on the caller's thread
+  kNone,
+
+  /// \brief STL, decoded by common::STLLoader
+  kStl,
+
+  /// \brief COLLADA, decoded by common::ColladaLoader
+  kCollada,
+
+  /// \brief Wavefront OBJ, decoded by common::OBJLoader
+  kObj
+};
+
+/// \brief Private data class for MeshLoader
+class MeshLoader::Implementation
+{
+  /// \brief Decode a mesh and mark it as done. Called on a worker thread.
+  /// \param[in] _uri Mesh name, as requested.
+  /// \param[in] _path Resolved mesh file.
+  /// \param[in] _format Format of the file.
+  public: void Load(const std::string &_uri, const std::string &_path,
+                    MeshFormat _format);
+
+  /// \brief A mesh being decoded, or decoded and not handed out yet
+  public: struct Entry
+  {
+    /// \brief True once decoding finished, successfully or not
+    bool done{false};
+
+    /// \brief True if the mesh was loaded by someone else meanwhile, and
+    /// the worker should drop the entry when it finishes
+    bool discard{false};
+
+    /// \brief Decoded mesh which wasn't added to common::MeshManager yet
+    std::unique_ptr<common::Mesh> decoded;
+  };
+
+  /// \brief Protects all members below
+  public: mutable std::mutex mutex;
+
+  /// \brief Notified when a mesh finishes loading
+  public: std::condition_variable loaded;
+
+  /// \brief Meshes in flight keyed by name. Entries are removed once the
+  /// mesh is added to common::MeshManager, which caches it from then on.
+  public: std::unordered_map<std::string, Entry> meshes;
+
+  /// \brief Meshes which failed to load, so they aren't retried every frame
+  public: std::unordered_set<std::string> failed;
+
+  /// \brief Number of requested meshes not done yet
+  public: std::size_t pending{0u};
+
+  /// \brief Total time spent blocked in Mesh()
+  public: std::chrono::steady_clock::duration blockingTime{0};
+
+  /// \brief Worker threads. Declared last so they're joined before the
+  /// members they use are destroyed.
+  public: std::unique_ptr<common::WorkerPool> pool;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the format a mesh file is decoded as in the background. Only
+/// formats with a dedicated loader in common::MeshManager::Load are, and
+/// none of them when GZ_MESH_FORCE_ASSIMP is set. Everything else keeps
+/// going through the manager, so its loader choice stays in one place.
+/// \param[in] _path Resolved mesh file.
+/// \return Format, kNone if the manager should load the file.
+static MeshFormat backgroundFormat(const std::string &_path)
+{
+  const std::string extension =
+      common::lowercase(_path.substr(_path.rfind('.') + 1));
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+    return MeshFormat::kStl;
+
+  std::string forceAssimp;
+  if (common::env("GZ_MESH_FORCE_ASSIMP", forceAssimp) && !forceAssimp.empty())
+    return MeshFormat::kNone;
+
+  if (extension == "dae")
+    return MeshFormat::kCollada;
+  if (extension == "obj")
+    return MeshFormat::kObj;
+  return MeshFormat::kNone;
+}
+
+/////////////////////////////////////////////////
+void MeshLoader::Implementation::Load(const std::string &_uri,
+    const std::string &_path, MeshFormat _format)
+{
+  // Each call uses its own loader, which only reads the resolved file and
+  // the files next to it, so calls can run in parallel
+  std::unique_ptr<common::Mesh> mesh;
+  switch (_format)
+  {
+    case MeshFormat::kStl:
+    {
+      common::STLLoader loader;
+      mesh.reset(loader.Load(_path));
+      break;
+    }
+    case MeshFormat::kCollada:
+    {
+      common::ColladaLoader loader;
+      mesh.reset(loader.Load(_path));
+      break;
+    }
+    case MeshFormat::kObj:
+    {
+      common::OBJLoader loader;
+      mesh.reset(loader.Load(_path));
+      break;
+    }
+    case MeshFormat::kNone:
+      break;
+  }
+
+  if (nullptr == mesh)
+    gzerr << "Failed to load mesh [" << _uri << "]" << std::endl;
+  else
+    mesh->SetName(_uri);
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->meshes.find(_uri);
+    if (it->second.discard)
+    {
+      this->meshes.erase(it);
+    }
+    else
+    {
+      it->second.decoded = std::move(mesh);
+      it->second.done = true;
+    }
+    --this->pending;
+  }
+  this->loaded.notify_all();
+}
+
+/////////////////////////////////////////////////
+MeshLoader::MeshLoader(unsigned int _threadCount)
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->pool = std::make_unique<common::WorkerPool>(_threadCount);
+}
+
+/////////////////////////////////////////////////
+MeshLoader::~MeshLoader() = default;
+
+/////////////////////////////////////////////////
+void MeshLoader::Prefetch(const std::string &_uri)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->meshes.count(_uri) ||
+        this->dataPtr->failed.count(_uri))
+    {
+      return;
+    }
+  }
+
+  if (common::MeshManager::Instance()->HasMesh(_uri))
+    return;
+
+  // Resolved here rather than on the workers, since resource paths aren't
+  // safe to use from several threads
+  const std::string path = common::findFile(_uri);
+  if (path.empty())
+  {
+    gzerr << "Failed to load mesh [" << _uri << "]" << std::endl;
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->failed.insert(_uri);
+    return;
+  }
+
+  const MeshFormat format = backgroundFormat(path);
+  if (format == MeshFormat::kNone)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->meshes.try_emplace(_uri);
+    ++this->dataPtr->pending;
+  }
+
+  auto impl = this->dataPtr.get();
+  this->dataPtr->pool->AddWork([impl, _uri, path, format]()
+  {
+    impl->Load(_uri, path, format);
+  });
+}
+
+/////////////////////////////////////////////////
+bool MeshLoader::IsReady(const std::string &_uri)
+{
+  this->Prefetch(_uri);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->meshes.find(_uri);
+  return it == this->dataPtr->meshes.end() || it->second.done;
+}
+
+/////////////////////////////////////////////////
+const common::Mesh *MeshLoader::Mesh(const std::string &_uri)
+{
+  auto manager = common::MeshManager::Instance();
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->meshes.find(_uri);
+
+  // Loaded by another user of the manager, drop our copy
+  if (manager->HasMesh(_uri))
+  {
+    if (it != this->dataPtr->meshes.end())
+    {
+      if (it->second.done)
+        this->dataPtr->meshes.erase(it);
+      else
+        it->second.discard = true;
+    }
+    return manager->MeshByName(_uri);
+  }
+
+  if (this->dataPtr->failed.count(_uri))
+    return nullptr;
+
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_ptr<common::Mesh> decoded;
+  if (it != this->dataPtr->meshes.end())
+  {
+    // References to map elements stay valid while other meshes are added
+    // or removed
+    auto &entry = it->second;
+    if (!entry.done)
+    {
+      this->dataPtr->loaded.wait(lock, [&entry]
+      {
+        return entry.done;
+      });
+      this->dataPtr->blockingTime += std::chrono::steady_clock::now() - start;
+    }
+    decoded = std::move(entry.decoded);
+    this->dataPtr->meshes.erase(it);
+  }
+  else
+  {
+    // Never requested, or not a background format, load it right here
+    lock.unlock();
+    auto mesh = manager->Load(_uri);
+    lock.lock();
+    this->dataPtr->blockingTime += std::chrono::steady_clock::now() - start;
+    if (nullptr == mesh)
+      this->dataPtr->failed.insert(_uri);
+    return mesh;
+  }
+
+  if (nullptr == decoded)
+  {
+    this->dataPtr->failed.insert(_uri);
+    return nullptr;
+  }
+  manager->AddMesh(decoded.release());
+  return manager->MeshByName(_uri);
+}
+
+/////////////////////////////////////////////////
+std::chrono::steady_clock::duration MeshLoader::BlockingTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->blockingTime;
+}
+
+/////////////////////////////////////////////////
+std::size_t MeshLoader::PendingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->pending;
+}
+}  // namespace gz::gui::plugins
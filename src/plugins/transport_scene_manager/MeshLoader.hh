@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MESHLOADER_HH_
+#define GZ_GUI_PLUGINS_MESHLOADER_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <gz/common/Mesh.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#ifndef _WIN32
+#  define MeshLoader_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define MeshLoader_EXPORTS_API __declspec(dllexport)
+#  else
+#    define MeshLoader_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Decodes mesh files on a pool of worker threads, so the render
+  /// thread only has to create the rendering mesh from data which is
+  /// already in memory.
+  ///
+  /// Meshes are requested with Prefetch. The render thread checks IsReady
+  /// and defers creating visuals until their mesh is available. Mesh never
+  /// blocks for meshes which are ready, and otherwise waits for them, or
+  /// loads them synchronously if they were never requested. The time spent
+  /// waiting is reported by BlockingTime.
+  ///
+  /// Only STL, COLLADA and OBJ files are decoded in the background, each
+  /// by its own instance of the loader common::MeshManager uses for the
+  /// format. Workers get a file path which was already resolved and never
+  /// touch the manager or the resource paths, so they decode in parallel
+  /// without sharing state. Other formats, and all of them when
+  /// GZ_MESH_FORCE_ASSIMP is set, are loaded by the manager in Mesh.
+  ///
+  /// Textures aren't decoded here, the render engine still loads them on
+  /// the render thread when the rendering mesh is created.
+  ///
+  /// All functions use common::MeshManager, so they must be called from the
+  /// thread which uses the manager, usually the render thread. Meshes are
+  /// only kept until Mesh adds them to the manager.
+  class MeshLoader_EXPORTS_API MeshLoader
+  {
+    /// \brief Constructor
+    /// \param[in] _threadCount Number of worker threads.
+    public: explicit MeshLoader(unsigned int _threadCount = 2u);
+
+    /// \brief Destructor. Waits for the meshes currently being loaded,
+    /// meshes still queued are not loaded.
+    public: ~MeshLoader();
+
+    /// \brief Start loading a mesh in the background, unless it has already
+    /// been requested or common::MeshManager already has it.
+    /// \param[in] _uri Mesh file.
+    public: void Prefetch(const std::string &_uri);
+
+    /// \brief Check whether a mesh has finished loading, successfully or
+    /// not. Starts loading it if it wasn't requested yet.
+    /// \param[in] _uri Mesh file.
+    /// \return True if Mesh won't wait for a worker.
+    public: bool IsReady(const std::string &_uri);
+
+    /// \brief Get a loaded mesh, blocking until it's available, and add it
+    /// to the common::MeshManager. If the manager already has a mesh for
+    /// the file, that one is returned instead.
+    /// \param[in] _uri Mesh file.
+    /// \return The mesh, owned by common::MeshManager, or null if it
+    /// failed to load.
+    public: const common::Mesh *Mesh(const std::string &_uri);
+
+    /// \brief Total time spent blocked in calls to Mesh.
+    /// \return Blocking time.
+    public: std::chrono::steady_clock::duration BlockingTime() const;
+
+    /// \brief Number of meshes requested and not loaded yet.
+    /// \return Number of pending meshes.
+    public: std::size_t PendingCount() const;
+
+    /// \internal
+    /// \brief Pointer to private data.
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MESHLOADER_HH_
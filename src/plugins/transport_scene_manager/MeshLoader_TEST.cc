@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/MeshManager.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "MeshLoader.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+class MeshLoaderTest : public ::testing::Test
+{
+  // Documentation inherited
+  protected: void SetUp() override
+  {
+    this->dir = common::createTempDirectory("mesh_loader",
+        common::tempDirectoryPath());
+    ASSERT_FALSE(this->dir.empty());
+  }
+
+  // Documentation inherited
+  protected: void TearDown() override
+  {
+    common::removeAll(this->dir);
+  }
+
+  /// \brief Copy the test mesh to new files, so each one is actually loaded
+  /// instead of being found in the mesh manager.
+  /// \param[in] _prefix File name prefix.
+  /// \param[in] _count Number of copies.
+  /// \return Paths to the copies.
+  protected: std::vector<std::string> CopyMesh(const std::string &_prefix,
+                                               unsigned int _count)
+  {
+    const auto source = common::joinPaths(PROJECT_SOURCE_PATH, "test",
+        "media", "box.obj");
+    std::vector<std::string> paths;
+    for (unsigned int i = 0u; i < _count; ++i)
+    {
+      paths.push_back(common::joinPaths(this->dir,
+          _prefix + std::to_string(i) + ".obj"));
+      EXPECT_TRUE(common::copyFile(source, paths.back()));
+    }
+    return paths;
+  }
+
+  /// \brief Temporary directory for mesh copies.
+  protected: std::string dir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(MeshLoaderTest, Prefetch)
+{
+  auto paths = this->CopyMesh("prefetch", 20u);
+
+  MeshLoader loader;
+  for (const auto &path : paths)
+    loader.Prefetch(path);
+
+  // Simulate render frames which only create visuals for ready meshes
+  std::size_t created{0u};
+  std::vector<bool> done(paths.size(), false);
+  for (int frame = 0; frame < 1000 && created < paths.size(); ++frame)
+  {
+    for (std::size_t i = 0u; i < paths.size(); ++i)
+    {
+      if (done[i] || !loader.IsReady(paths[i]))
+        continue;
+      auto mesh = loader.Mesh(paths[i]);
+      EXPECT_NE(nullptr, mesh);
+
+      // Added to the mesh manager once it's used
+      EXPECT_EQ(mesh, common::MeshManager::Instance()->MeshByName(paths[i]));
+      done[i] = true;
+      ++created;
+    }
+    std::this_thread::sleep_for(5ms);
+  }
+  EXPECT_EQ(paths.size(), created);
+  EXPECT_EQ(0u, loader.PendingCount());
+
+  // The render thread never waited for a mesh
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      loader.BlockingTime());
+
+  // Missing files are ready too, and return null
+  const auto missing = common::joinPaths(this->dir, "missing.obj");
+  loader.Prefetch(missing);
+  while (!loader.IsReady(missing))
+    std::this_thread::sleep_for(1ms);
+  EXPECT_EQ(nullptr, loader.Mesh(missing));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshLoaderTest, Blocking)
+{
+  auto paths = this->CopyMesh("blocking", 20u);
+
+  // Without prefetching, the render thread loads every mesh itself
+  MeshLoader loader;
+  for (const auto &path : paths)
+    EXPECT_NE(nullptr, loader.Mesh(path));
+
+  EXPECT_GT(loader.BlockingTime(), std::chrono::steady_clock::duration::zero());
+  EXPECT_EQ(0u, loader.PendingCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshLoaderTest, ExistingMesh)
+{
+  auto paths = this->CopyMesh("existing", 2u);
+  auto manager = common::MeshManager::Instance();
+
+  // Meshes the manager already has aren't decoded again
+  MeshLoader loader;
+  auto existing = manager->Load(paths[0]);
+  ASSERT_NE(nullptr, existing);
+  loader.Prefetch(paths[0]);
+  EXPECT_EQ(0u, loader.PendingCount());
+  EXPECT_TRUE(loader.IsReady(paths[0]));
+  EXPECT_EQ(existing, loader.Mesh(paths[0]));
+
+  // Loaded through the manager while the loader decodes its own copy
+  loader.Prefetch(paths[1]);
+  existing = manager->Load(paths[1]);
+  ASSERT_NE(nullptr, existing);
+
+  // The manager's mesh is kept, and the copy dropped once decoded
+  EXPECT_EQ(existing, loader.Mesh(paths[1]));
+  EXPECT_EQ(existing, loader.Mesh(paths[1]));
+  for (int i = 0; i < 1000 && loader.PendingCount() > 0u; ++i)
+    std::this_thread::sleep_for(1ms);
+  EXPECT_EQ(0u, loader.PendingCount());
+  EXPECT_TRUE(loader.IsReady(paths[1]));
+  EXPECT_EQ(existing, loader.Mesh(paths[1]));
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_PENDINGPOSES_HH_
+#define GZ_GUI_PLUGINS_PENDINGPOSES_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+
+#include <gz/math/Pose3.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Bounded store of poses received for entities which haven't been
+  /// created yet, so they can be applied as soon as the entity is loaded
+  /// instead of being dropped.
+  ///
+  /// Only the newest pose of each entity is kept. Poses older than the
+  /// maximum age, measured in the time of the pose messages, are discarded,
+  /// and so are the oldest poses once the capacity is reached.
+  ///
+  /// Poses arrive in frames which may merge several messages, so their
+  /// stamps aren't in order within a frame. Time is advanced once per
+  /// frame with Advance, which is also where a reset of the message time
+  /// is detected.
+  class PendingPoses
+  {
+    /// \brief Set the maximum number of entities with a pending pose.
+    /// \param[in] _capacity Maximum number of entities.
+    public: void SetCapacity(std::size_t _capacity)
+    {
+      this->capacity = _capacity;
+      this->Prune();
+    }
+
+    /// \brief Set the maximum age of pending poses.
+    /// \param[in] _maxAge Maximum age, in message time.
+    public: void SetMaxAge(std::chrono::steady_clock::duration _maxAge)
+    {
+      this->maxAge = _maxAge;
+      this->Prune();
+    }
+
+    /// \brief Store the pose of an entity, replacing any previous one.
+    /// \param[in] _id Entity id.
+    /// \param[in] _pose Entity pose.
+    /// \param[in] _stamp Time of the pose message. Older stamps than the
+    /// latest one are kept as they are, they don't reset the time.
+    public: void Add(unsigned int _id, const math::Pose3d &_pose,
+                     std::chrono::steady_clock::duration _stamp)
+    {
+      if (0u == this->capacity)
+      {
+        ++this->dropped;
+        return;
+      }
+
+      this->latest = std::max(this->latest, _stamp);
+
+      const std::uint64_t seq = this->nextSeq++;
+      this->entries[_id] = {_pose, _stamp, seq};
+      this->order.emplace_back(_id, seq);
+      this->Prune();
+    }
+
+    /// \brief Advance the message time poses are aged against to the
+    /// newest stamp of a frame of poses, including the poses of entities
+    /// which already exist, which aren't added. Call once per frame, before
+    /// adding its poses. Poses which got too old are dropped.
+    /// \param[in] _stamp Newest stamp of the frame. If it's older than the
+    /// latest one, time went backwards, e.g. the world was reset, and all
+    /// pending poses are dropped. Zero, for frames without stamps, is
+    /// ignored.
+    public: void Advance(std::chrono::steady_clock::duration _stamp)
+    {
+      if (_stamp.count() == 0)
+        return;
+
+      if (_stamp < this->latest)
+      {
+        this->dropped += this->entries.size();
+        this->Clear();
+      }
+      this->latest = _stamp;
+      this->Prune();
+    }
+
+    /// \brief Remove the pending pose of an entity.
+    /// \param[in] _id Entity id.
+    /// \return True if there was a pending pose.
+    public: bool Erase(unsigned int _id)
+    {
+      return this->entries.erase(_id) > 0u;
+    }
+
+    /// \brief Remove the pending pose of an entity, to apply it. Poses
+    /// which got too old since they were added are dropped first.
+    /// \param[in] _id Entity id.
+    /// \param[out] _pose Entity pose.
+    /// \return True if there was a pending pose.
+    public: bool Take(unsigned int _id, math::Pose3d &_pose)
+    {
+      this->Prune();
+
+      auto it = this->entries.find(_id);
+      if (it == this->entries.end())
+        return false;
+
+      _pose = it->second.pose;
+      this->entries.erase(it);
+      return true;
+    }
+
+    /// \brief Number of entities with a pending pose.
+    /// \return Number of pending poses.
+    public: std::size_t Size() const
+    {
+      return this->entries.size();
+    }
+
+    /// \brief Total number of poses discarded because they were too old or
+    /// over capacity.
+    /// \return Number of poses.
+    public: std::uint64_t DroppedCount() const
+    {
+      return this->dropped;
+    }
+
+    /// \brief Remove all pending poses.
+    public: void Clear()
+    {
+      this->entries.clear();
+      this->order.clear();
+    }
+
+    /// \brief Drop poses that are too old or over capacity, oldest first.
+    private: void Prune()
+    {
+      while (!this->order.empty())
+      {
+        const auto [id, seq] = this->order.front();
+        auto it = this->entries.find(id);
+
+        // Entry was replaced, taken or erased since
+        const bool stale = it == this->entries.end() || it->second.seq != seq;
+        const bool expired = !stale &&
+            (this->entries.size() > this->capacity ||
+            this->latest - it->second.stamp > this->maxAge);
+        if (!stale && !expired)
+          break;
+
+        if (expired)
+        {
+          this->entries.erase(it);
+          ++this->dropped;
+        }
+        this->order.pop_front();
+      }
+
+      // Compact if the order queue is mostly stale entries
+      if (this->order.size() > 2u * this->entries.size() + 64u)
+      {
+        std::deque<std::pair<unsigned int, std::uint64_t>> compacted;
+        for (const auto &[id, seq] : this->order)
+        {
+          auto it = this->entries.find(id);
+          if (it != this->entries.end() && it->second.seq == seq)
+            compacted.emplace_back(id, seq);
+        }
+        this->order.swap(compacted);
+      }
+    }
+
+    /// \brief A pending pose.
+    private: struct Entry
+    {
+      /// \brief Entity pose.
+      math::Pose3d pose;
+
+      /// \brief Time of the pose message.
+      std::chrono::steady_clock::duration stamp;
+
+      /// \brief Insertion sequence number, used to match order entries.
+      std::uint64_t seq;
+    };
+
+    /// \brief Pending poses keyed by entity id.
+    private: std::unordered_map<unsigned int, Entry> entries;
+
+    /// \brief Entity ids in insertion order, with their sequence number.
+    private: std::deque<std::pair<unsigned int, std::uint64_t>> order;
+
+    /// \brief Maximum number of pending poses.
+    private: std::size_t capacity{10000u};
+
+    /// \brief Maximum age of a pending pose.
+    private: std::chrono::steady_clock::duration maxAge{
+        std::chrono::seconds(5)};
+
+    /// \brief Time of the newest pose added.
+    private: std::chrono::steady_clock::duration latest{0};
+
+    /// \brief Next insertion sequence number.
+    private: std::uint64_t nextSeq{0u};
+
+    /// \brief Number of poses discarded.
+    private: std::uint64_t dropped{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_PENDINGPOSES_HH_
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <gz/math/Pose3.hh>
+
+#include "PendingPoses.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(PendingPosesTest, AddTake)
+{
+  PendingPoses pending;
+  EXPECT_EQ(0u, pending.Size());
+
+  pending.Add(1u, math::Pose3d(1, 0, 0, 0, 0, 0), 1s);
+  pending.Add(2u, math::Pose3d(2, 0, 0, 0, 0, 0), 1s);
+  pending.Add(1u, math::Pose3d(3, 0, 0, 0, 0, 0), 2s);
+  EXPECT_EQ(2u, pending.Size());
+
+  // Only entity 1 was loaded
+  math::Pose3d pose;
+  EXPECT_TRUE(pending.Take(1u, pose));
+  EXPECT_EQ(math::Pose3d(3, 0, 0, 0, 0, 0), pose);
+  EXPECT_FALSE(pending.Take(1u, pose));
+  EXPECT_FALSE(pending.Take(3u, pose));
+  EXPECT_EQ(1u, pending.Size());
+
+  EXPECT_TRUE(pending.Erase(2u));
+  EXPECT_FALSE(pending.Erase(2u));
+  EXPECT_EQ(0u, pending.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PendingPosesTest, MaxAge)
+{
+  PendingPoses pending;
+  pending.SetMaxAge(2s);
+
+  pending.Add(1u, math::Pose3d::Zero, 1s);
+  pending.Add(2u, math::Pose3d::Zero, 2s);
+  pending.Add(3u, math::Pose3d::Zero, 3s);
+  EXPECT_EQ(3u, pending.Size());
+
+  // Entity 1 is now older than 2 s
+  pending.Add(4u, math::Pose3d::Zero, 3500ms);
+  EXPECT_EQ(3u, pending.Size());
+
+  // Refreshing an entity keeps it alive
+  pending.Add(2u, math::Pose3d::Zero, 4s);
+  pending.Add(5u, math::Pose3d::Zero, 5100ms);
+  EXPECT_EQ(3u, pending.Size());
+  EXPECT_FALSE(pending.Erase(3u));
+  EXPECT_TRUE(pending.Erase(2u));
+
+  // Poses of existing entities age the pending ones too
+  pending.Add(7u, math::Pose3d::Zero, 5200ms);
+  pending.Advance(6s);
+  EXPECT_EQ(2u, pending.Size());
+  pending.Advance(0s);
+  EXPECT_EQ(2u, pending.Size());
+  pending.Advance(7500ms);
+  math::Pose3d pose;
+  EXPECT_FALSE(pending.Take(5u, pose));
+  EXPECT_FALSE(pending.Take(7u, pose));
+  EXPECT_EQ(0u, pending.Size());
+
+  // Time going backwards discards everything
+  pending.Add(6u, math::Pose3d::Zero, 7500ms);
+  EXPECT_EQ(1u, pending.Size());
+  const auto dropped = pending.DroppedCount();
+  pending.Advance(1s);
+  EXPECT_EQ(0u, pending.Size());
+  EXPECT_EQ(dropped + 1u, pending.DroppedCount());
+  pending.Add(6u, math::Pose3d::Zero, 1s);
+  EXPECT_EQ(1u, pending.Size());
+  EXPECT_TRUE(pending.Erase(6u));
+}
+
+/////////////////////////////////////////////////
+TEST(PendingPosesTest, MixedStamps)
+{
+  PendingPoses pending;
+  pending.SetMaxAge(2s);
+  pending.Advance(10s);
+  pending.Add(1u, math::Pose3d(1, 0, 0, 0, 0, 0), 10s);
+
+  // A frame merging several messages, whose poses aren't in stamp order
+  pending.Advance(11s);
+  pending.Add(2u, math::Pose3d(2, 0, 0, 0, 0, 0), 11s);
+  pending.Add(3u, math::Pose3d(3, 0, 0, 0, 0, 0), 10500ms);
+  pending.Add(4u, math::Pose3d(4, 0, 0, 0, 0, 0), 11s);
+
+  // The older stamp isn't a reset, nothing is dropped
+  EXPECT_EQ(4u, pending.Size());
+  EXPECT_EQ(0u, pending.DroppedCount());
+
+  math::Pose3d pose;
+  EXPECT_TRUE(pending.Take(1u, pose));
+  EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), pose);
+  EXPECT_TRUE(pending.Take(3u, pose));
+  EXPECT_EQ(math::Pose3d(3, 0, 0, 0, 0, 0), pose);
+  EXPECT_EQ(2u, pending.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PendingPosesTest, Capacity)
+{
+  PendingPoses pending;
+  pending.SetCapacity(3u);
+
+  for (unsigned int id = 0u; id < 10u; ++id)
+    pending.Add(id, math::Pose3d::Zero, 0s);
+  EXPECT_EQ(3u, pending.Size());
+  EXPECT_EQ(7u, pending.DroppedCount());
+
+  // The newest are kept
+  EXPECT_TRUE(pending.Erase(9u));
+  EXPECT_TRUE(pending.Erase(8u));
+  EXPECT_TRUE(pending.Erase(7u));
+
+  // Repeated updates to the same entities don't grow the store
+  for (int i = 0; i < 1000; ++i)
+    pending.Add(i % 2, math::Pose3d::Zero, 0s);
+  EXPECT_EQ(2u, pending.Size());
+
+  pending.SetCapacity(0u);
+  EXPECT_EQ(0u, pending.Size());
+  pending.Add(1u, math::Pose3d::Zero, 0s);
+  EXPECT_EQ(0u, pending.Size());
+  EXPECT_EQ(10u, pending.DroppedCount());
+}
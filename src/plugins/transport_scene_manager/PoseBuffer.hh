@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_POSEBUFFER_HH_
+#define GZ_GUI_PLUGINS_POSEBUFFER_HH_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Pose of a single entity.
+  struct EntityPose
+  {
+    /// \brief Entity id.
+    unsigned int id{0u};
+
+    /// \brief Entity pose.
+    math::Pose3d pose;
+
+    /// \brief Time of the message the pose came from.
+    std::chrono::steady_clock::duration stamp{0};
+  };
+
+  /// \brief Set of entity poses which keeps only the newest pose of each
+  /// entity, stored contiguously.
+  class PoseFrame
+  {
+    /// \brief Set the pose of an entity, replacing any previous pose for
+    /// the same entity.
+    /// \param[in] _id Entity id.
+    /// \param[in] _pose Entity pose.
+    /// \param[in] _stamp Time of the message the pose came from.
+    public: void Set(unsigned int _id, const math::Pose3d &_pose,
+                     std::chrono::steady_clock::duration _stamp =
+                         std::chrono::steady_clock::duration::zero())
+    {
+      auto [it, inserted] = this->index.try_emplace(_id, this->poses.size());
+      if (inserted)
+        this->poses.push_back({_id, _pose, _stamp});
+      else
+        this->poses[it->second] = {_id, _pose, _stamp};
+    }
+
+    /// \brief Remove the pose of an entity.
+    /// \param[in] _id Entity id.
+    /// \return True if the frame had a pose for the entity.
+    public: bool Erase(unsigned int _id)
+    {
+      auto it = this->index.find(_id);
+      if (it == this->index.end())
+        return false;
+
+      const std::size_t removed = it->second;
+      this->index.erase(it);
+      if (removed != this->poses.size() - 1)
+      {
+        this->poses[removed] = this->poses.back();
+        this->index[this->poses[removed].id] = removed;
+      }
+      this->poses.pop_back();
+      return true;
+    }
+
+    /// \brief Record when a message with poses for this frame was
+    /// received. The earliest time is kept until the frame is cleared.
+    /// \param[in] _time Receive time.
+    public: void MarkReceived(std::chrono::steady_clock::time_point _time)
+    {
+      if (this->received == std::chrono::steady_clock::time_point() ||
+          _time < this->received)
+      {
+        this->received = _time;
+      }
+    }
+
+    /// \brief When the oldest message with poses in this frame was
+    /// received.
+    /// \return Receive time, epoch if never marked.
+    public: std::chrono::steady_clock::time_point Received() const
+    {
+      return this->received;
+    }
+
+    /// \brief Remove all poses. Allocated storage is kept for reuse.
+    public: void Clear()
+    {
+      this->poses.clear();
+      this->index.clear();
+      this->received = std::chrono::steady_clock::time_point();
+    }
+
+    /// \brief Whether the frame has no poses.
+    /// \return True if empty.
+    public: bool Empty() const
+    {
+      return this->poses.empty();
+    }
+
+    /// \brief Poses in the frame, one per entity.
+    /// \return Poses.
+    public: const std::vector<EntityPose> &Poses() const
+    {
+      return this->poses;
+    }
+
+    /// \brief Dense pose storage.
+    private: std::vector<EntityPose> poses;
+
+    /// \brief Entity id to index in poses.
+    private: std::unordered_map<unsigned int, std::size_t> index;
+
+    /// \brief Receive time of the oldest message.
+    private: std::chrono::steady_clock::time_point received;
+  };
+
+  /// \brief Lock-free single producer, single consumer handoff of pose
+  /// frames, implemented as a triple buffer.
+  ///
+  /// The producer fills WriteFrame() and calls Publish(), which never
+  /// blocks. The consumer calls Acquire() to get the most recently
+  /// published frame, also without blocking. If the consumer didn't acquire
+  /// a published frame before the next one was published, the poses of the
+  /// skipped frame that were not superseded are carried over into the
+  /// producer's next frame, so only the newest pose of each entity is ever
+  /// delivered and none is delivered out of order.
+  class PoseBuffer
+  {
+    /// \brief Frame being written by the producer. Producers on several
+    /// threads must serialize their WriteFrame() and Publish() calls.
+    /// \return Frame to write into.
+    public: PoseFrame &WriteFrame()
+    {
+      return this->frames[this->back];
+    }
+
+    /// \brief Publish the write frame to the consumer. Only call from the
+    /// producer which wrote it.
+    public: void Publish()
+    {
+      // Only the producer sets the fresh bit, so if it's clear now the
+      // previous frame has been acquired and the exchange below will hand
+      // back a consumed frame.
+      const bool mayBeStale =
+          this->middle.load(std::memory_order_acquire) & kFresh;
+      if (mayBeStale)
+      {
+        this->published.clear();
+        for (const auto &entityPose : this->frames[this->back].Poses())
+          this->published.push_back(entityPose.id);
+      }
+
+      const std::uint8_t prev = this->middle.exchange(
+          static_cast<std::uint8_t>(this->back | kFresh),
+          std::memory_order_acq_rel);
+      this->back = prev & kIndexMask;
+
+      PoseFrame &frame = this->frames[this->back];
+      if (prev & kFresh)
+      {
+        // The consumer never saw this frame. Keep the poses of entities
+        // which weren't superseded by the frame just published.
+        for (const unsigned int id : this->published)
+          frame.Erase(id);
+        if (frame.Empty())
+          frame.Clear();
+      }
+      else
+      {
+        frame.Clear();
+      }
+    }
+
+    /// \brief Get the most recently published frame. Only call from the
+    /// consumer thread.
+    /// \return The newest frame, or nullptr if nothing was published since
+    /// the last call. The frame is valid until the next call.
+    public: const PoseFrame *Acquire()
+    {
+      if (!(this->middle.load(std::memory_order_acquire) & kFresh))
+        return nullptr;
+
+      const std::uint8_t prev =
+          this->middle.exchange(this->front, std::memory_order_acq_rel);
+      this->front = prev & kIndexMask;
+      return &this->frames[this->front];
+    }
+
+    /// \brief Bit of the middle state set when it holds an unread frame.
+    private: static constexpr std::uint8_t kFresh{0x4};
+
+    /// \brief Bits of the middle state holding the frame index.
+    private: static constexpr std::uint8_t kIndexMask{0x3};
+
+    /// \brief The three frames.
+    private: std::array<PoseFrame, 3> frames;
+
+    /// \brief Index of the frame shared between producer and consumer,
+    /// plus the fresh bit.
+    private: std::atomic<std::uint8_t> middle{1u};
+
+    /// \brief Index of the producer's frame.
+    private: std::uint8_t back{0u};
+
+    /// \brief Index of the consumer's frame.
+    private: std::uint8_t front{2u};
+
+    /// \brief Producer's scratch list of the entities in the frame being
+    /// published.
+    private: std::vector<unsigned int> published;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_POSEBUFFER_HH_
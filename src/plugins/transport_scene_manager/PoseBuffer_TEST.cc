@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+#include <gz/math/Pose3.hh>
+
+#include "PoseBuffer.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, Frame)
+{
+  PoseFrame frame;
+  EXPECT_TRUE(frame.Empty());
+
+  frame.Set(1u, math::Pose3d(1, 0, 0, 0, 0, 0));
+  frame.Set(2u, math::Pose3d(2, 0, 0, 0, 0, 0));
+  frame.Set(1u, math::Pose3d(3, 0, 0, 0, 0, 0));
+  ASSERT_EQ(2u, frame.Poses().size());
+  EXPECT_EQ(1u, frame.Poses()[0].id);
+  EXPECT_EQ(math::Pose3d(3, 0, 0, 0, 0, 0), frame.Poses()[0].pose);
+
+  EXPECT_TRUE(frame.Erase(1u));
+  EXPECT_FALSE(frame.Erase(1u));
+  ASSERT_EQ(1u, frame.Poses().size());
+  EXPECT_EQ(2u, frame.Poses()[0].id);
+
+  // The oldest receive time is kept
+  const auto now = std::chrono::steady_clock::now();
+  frame.MarkReceived(now);
+  frame.MarkReceived(now + std::chrono::seconds(1));
+  EXPECT_EQ(now, frame.Received());
+  frame.MarkReceived(now - std::chrono::seconds(1));
+  EXPECT_EQ(now - std::chrono::seconds(1), frame.Received());
+
+  frame.Clear();
+  EXPECT_TRUE(frame.Empty());
+  EXPECT_EQ(std::chrono::steady_clock::time_point(), frame.Received());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, Handoff)
+{
+  PoseBuffer buffer;
+  EXPECT_EQ(nullptr, buffer.Acquire());
+
+  buffer.WriteFrame().Set(1u, math::Pose3d(1, 0, 0, 0, 0, 0));
+  buffer.Publish();
+
+  auto frame = buffer.Acquire();
+  ASSERT_NE(nullptr, frame);
+  ASSERT_EQ(1u, frame->Poses().size());
+  EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), frame->Poses()[0].pose);
+
+  // Each frame is delivered once
+  EXPECT_EQ(nullptr, buffer.Acquire());
+
+  // Consumed frames are recycled empty
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(buffer.WriteFrame().Empty());
+    buffer.WriteFrame().Set(2u, math::Pose3d(i, 0, 0, 0, 0, 0));
+    buffer.Publish();
+    frame = buffer.Acquire();
+    ASSERT_NE(nullptr, frame);
+    ASSERT_EQ(1u, frame->Poses().size());
+    EXPECT_EQ(2u, frame->Poses()[0].id);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, SkippedFrame)
+{
+  PoseBuffer buffer;
+
+  // Two frames published before the consumer reads
+  buffer.WriteFrame().Set(1u, math::Pose3d(1, 0, 0, 0, 0, 0));
+  buffer.WriteFrame().Set(2u, math::Pose3d(1, 0, 0, 0, 0, 0));
+  buffer.Publish();
+  buffer.WriteFrame().Set(1u, math::Pose3d(2, 0, 0, 0, 0, 0));
+  buffer.Publish();
+
+  auto frame = buffer.Acquire();
+  ASSERT_NE(nullptr, frame);
+  ASSERT_EQ(1u, frame->Poses().size());
+  EXPECT_EQ(1u, frame->Poses()[0].id);
+  EXPECT_EQ(math::Pose3d(2, 0, 0, 0, 0, 0), frame->Poses()[0].pose);
+
+  // The pose of entity 2 from the skipped frame is delivered with the next
+  // frame, and the stale pose of entity 1 is not
+  buffer.WriteFrame().Set(3u, math::Pose3d(3, 0, 0, 0, 0, 0));
+  buffer.Publish();
+
+  frame = buffer.Acquire();
+  ASSERT_NE(nullptr, frame);
+  std::map<unsigned int, math::Pose3d> poses;
+  for (const auto &entityPose : frame->Poses())
+    poses[entityPose.id] = entityPose.pose;
+  EXPECT_EQ(2u, poses.size());
+  EXPECT_EQ(0u, poses.count(1u));
+  EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), poses[2u]);
+  EXPECT_EQ(math::Pose3d(3, 0, 0, 0, 0, 0), poses[3u]);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, Threaded)
+{
+  PoseBuffer buffer;
+  const unsigned int entityCount{50u};
+  const int frameCount{20000};
+  std::atomic<bool> done{false};
+
+  std::thread producer([&]()
+  {
+    for (int i = 1; i <= frameCount; ++i)
+    {
+      for (unsigned int id = 0u; id < entityCount; ++id)
+        buffer.WriteFrame().Set(id, math::Pose3d(i, 0, 0, 0, 0, 0));
+      buffer.Publish();
+    }
+    done = true;
+  });
+
+  // Poses must never go back in time, and the last one must be delivered
+  std::map<unsigned int, double> latest;
+  bool ordered{true};
+  auto consume = [&]()
+  {
+    while (auto frame = buffer.Acquire())
+    {
+      for (const auto &entityPose : frame->Poses())
+      {
+        const double x = entityPose.pose.Pos().X();
+        if (x < latest[entityPose.id])
+          ordered = false;
+        latest[entityPose.id] = x;
+      }
+    }
+  };
+  while (!done)
+    consume();
+  producer.join();
+  consume();
+
+  EXPECT_TRUE(ordered);
+  ASSERT_EQ(entityCount, latest.size());
+  for (const auto &[id, x] : latest)
+    EXPECT_DOUBLE_EQ(frameCount, x) << id;
+}
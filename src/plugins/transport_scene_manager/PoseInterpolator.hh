@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_POSEINTERPOLATOR_HH_
+#define GZ_GUI_PLUGINS_POSEINTERPOLATOR_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Jitter buffer which keeps the last few timestamped poses of
+  /// each entity and interpolates between them at render time.
+  ///
+  /// Poses are played out a fixed delay behind the newest pose received,
+  /// on a clock which advances with the render loop and is slowly pulled
+  /// towards that target. Positions are interpolated linearly and
+  /// rotations spherically. If no newer pose arrives in time, entities
+  /// stay at their newest pose instead of being extrapolated.
+  class PoseInterpolator
+  {
+    /// \brief Clock used to advance the playout time.
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Set the playout delay.
+    /// \param[in] _delay Time behind the newest pose, in message time.
+    public: void SetDelay(Clock::duration _delay)
+    {
+      this->delay = _delay;
+    }
+
+    /// \brief Get the playout delay.
+    /// \return Time behind the newest pose, in message time.
+    public: Clock::duration Delay() const
+    {
+      return this->delay;
+    }
+
+    /// \brief Set the number of poses kept per entity.
+    /// \param[in] _capacity Number of poses, at least 2.
+    public: void SetCapacity(std::size_t _capacity)
+    {
+      this->capacity = std::max<std::size_t>(_capacity, 2u);
+    }
+
+    /// \brief Add a timestamped pose.
+    /// \param[in] _id Entity id.
+    /// \param[in] _pose Entity pose.
+    /// \param[in] _stamp Time of the pose message.
+    public: void Add(unsigned int _id, const math::Pose3d &_pose,
+                     Clock::duration _stamp)
+    {
+      // Time went backwards, e.g. the world was reset. Start over.
+      if (this->started && _stamp + this->delay < this->latest)
+        this->Clear();
+
+      this->latest = std::max(this->latest, _stamp);
+
+      Track &track = this->tracks[_id];
+      if (!track.samples.empty() && _stamp <= track.samples.back().stamp)
+      {
+        // Same message time, keep the newest pose. Older ones arrived out
+        // of order and are dropped.
+        if (_stamp == track.samples.back().stamp)
+          track.samples.back().pose = _pose;
+        else
+          return;
+      }
+      else
+      {
+        track.samples.push_back({_stamp, _pose});
+        if (track.samples.size() > this->capacity)
+          track.samples.pop_front();
+      }
+
+      if (!track.active)
+      {
+        track.active = true;
+        this->active.push_back(_id);
+      }
+    }
+
+    /// \brief Remove all poses of an entity.
+    /// \param[in] _id Entity id.
+    public: void Erase(unsigned int _id)
+    {
+      auto it = this->tracks.find(_id);
+      if (it == this->tracks.end())
+        return;
+
+      if (it->second.active)
+      {
+        this->active.erase(std::remove(this->active.begin(),
+            this->active.end(), _id), this->active.end());
+      }
+      this->tracks.erase(it);
+    }
+
+    /// \brief Remove all poses and restart the playout clock.
+    public: void Clear()
+    {
+      this->tracks.clear();
+      this->active.clear();
+      this->latest = Clock::duration::zero();
+      this->started = false;
+    }
+
+    /// \brief Advance the playout clock and get the interpolated pose of
+    /// every entity which is still moving.
+    /// \param[in] _now Current render time.
+    /// \param[in] _apply Callback invoked as
+    /// `void(unsigned int _id, const math::Pose3d &_pose)`.
+    /// \return Number of poses passed to the callback.
+    public: template <typename ApplyFn>
+            std::size_t Update(Clock::time_point _now, ApplyFn &&_apply)
+    {
+      if (this->active.empty())
+      {
+        this->lastUpdate = _now;
+        return 0u;
+      }
+
+      const Clock::duration target = this->latest - this->delay;
+      if (!this->started)
+      {
+        this->playout = target;
+        this->started = true;
+      }
+      else
+      {
+        // Follow the render clock, corrected towards the target so the
+        // playout keeps up with streams not running in real time
+        this->playout += _now - this->lastUpdate;
+        this->playout += (target - this->playout) / 10;
+
+        // Far behind, e.g. after a pause, jump instead of catching up
+        if (this->playout < target - this->delay - std::chrono::seconds(1))
+          this->playout = target;
+
+        // Never extrapolate
+        this->playout = std::min(this->playout, this->latest);
+      }
+      this->lastUpdate = _now;
+
+      std::size_t applied{0u};
+      this->stillActive.clear();
+      for (const unsigned int id : this->active)
+      {
+        Track &track = this->tracks.at(id);
+        auto &samples = track.samples;
+
+        // Keep a single sample at or before the playout time
+        while (samples.size() > 1u && samples[1].stamp <= this->playout)
+          samples.pop_front();
+
+        if (samples.size() == 1u || this->playout <= samples[0].stamp)
+        {
+          _apply(id, samples[0].pose);
+        }
+        else
+        {
+          const auto &from = samples[0];
+          const auto &to = samples[1];
+          const double t =
+              std::chrono::duration<double>(this->playout - from.stamp) /
+              std::chrono::duration<double>(to.stamp - from.stamp);
+          _apply(id, Interpolate(from.pose, to.pose, t));
+        }
+        ++applied;
+
+        // Done once the newest sample has been applied
+        if (samples.size() == 1u && this->playout >= samples[0].stamp)
+          track.active = false;
+        else
+          this->stillActive.push_back(id);
+      }
+      this->active.swap(this->stillActive);
+      return applied;
+    }
+
+    /// \brief Number of entities with buffered poses.
+    /// \return Number of entities.
+    public: std::size_t Size() const
+    {
+      return this->tracks.size();
+    }
+
+    /// \brief Number of entities still being interpolated.
+    /// \return Number of entities.
+    public: std::size_t ActiveCount() const
+    {
+      return this->active.size();
+    }
+
+    /// \brief Current playout time.
+    /// \return Playout time, in message time.
+    public: Clock::duration PlayoutTime() const
+    {
+      return this->playout;
+    }
+
+    /// \brief Interpolate between two poses.
+    /// \param[in] _from Pose at 0.
+    /// \param[in] _to Pose at 1.
+    /// \param[in] _t Interpolation parameter, from 0 to 1.
+    /// \return Interpolated pose.
+    public: static math::Pose3d Interpolate(const math::Pose3d &_from,
+                                            const math::Pose3d &_to,
+                                            double _t)
+    {
+      return math::Pose3d(
+          _from.Pos() + (_to.Pos() - _from.Pos()) * _t,
+          math::Quaterniond::Slerp(_t, _from.Rot(), _to.Rot(), true));
+    }
+
+    /// \brief A timestamped pose.
+    private: struct Sample
+    {
+      /// \brief Time of the pose message.
+      Clock::duration stamp;
+
+      /// \brief Entity pose.
+      math::Pose3d pose;
+    };
+
+    /// \brief Buffered poses of an entity.
+    private: struct Track
+    {
+      /// \brief Poses, oldest first.
+      std::deque<Sample> samples;
+
+      /// \brief True if the entity is in the active list.
+      bool active{false};
+    };
+
+    /// \brief Buffered poses keyed by entity id.
+    private: std::unordered_map<unsigned int, Track> tracks;
+
+    /// \brief Entities whose poses haven't all been played out.
+    private: std::vector<unsigned int> active;
+
+    /// \brief Scratch list used while updating.
+    private: std::vector<unsigned int> stillActive;
+
+    /// \brief Playout delay.
+    private: Clock::duration delay{std::chrono::milliseconds(100)};
+
+    /// \brief Number of poses kept per entity.
+    private: std::size_t capacity{4u};
+
+    /// \brief Time of the newest pose received.
+    private: Clock::duration latest{0};
+
+    /// \brief Current playout time.
+    private: Clock::duration playout{0};
+
+    /// \brief Render time of the last update.
+    private: Clock::time_point lastUpdate;
+
+    /// \brief True once the playout clock has been started.
+    private: bool started{false};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_POSEINTERPOLATOR_HH_
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+
+#include <gz/math/Pose3.hh>
+
+#include "PoseInterpolator.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(PoseInterpolatorTest, Interpolate)
+{
+  const math::Pose3d from(0, 0, 0, 0, 0, 0);
+  const math::Pose3d to(2, 4, 0, 0, 0, 0);
+  EXPECT_EQ(from, PoseInterpolator::Interpolate(from, to, 0.0));
+  EXPECT_EQ(to, PoseInterpolator::Interpolate(from, to, 1.0));
+  EXPECT_EQ(math::Pose3d(1, 2, 0, 0, 0, 0),
+      PoseInterpolator::Interpolate(from, to, 0.5));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseInterpolatorTest, Playout)
+{
+  PoseInterpolator interpolator;
+  interpolator.SetDelay(100ms);
+
+  std::map<unsigned int, math::Pose3d> poses;
+  auto apply = [&poses](unsigned int _id, const math::Pose3d &_pose)
+  {
+    poses[_id] = _pose;
+  };
+
+  // A 10 Hz stream, rendered at 40 Hz
+  PoseInterpolator::Clock::time_point now;
+  std::chrono::milliseconds stamp{1000};
+  interpolator.Add(1u, math::Pose3d(0, 0, 0, 0, 0, 0), stamp);
+  interpolator.Add(2u, math::Pose3d(5, 0, 0, 0, 0, 0), stamp);
+  EXPECT_EQ(2u, interpolator.Update(now, apply));
+  EXPECT_EQ(900ms, interpolator.PlayoutTime());
+  EXPECT_EQ(math::Pose3d(0, 0, 0, 0, 0, 0), poses[1u]);
+
+  int frames{0};
+  for (int i = 1; i <= 10; ++i)
+  {
+    stamp += 100ms;
+    interpolator.Add(1u, math::Pose3d(i, 0, 0, 0, 0, 0), stamp);
+    for (int f = 0; f < 4; ++f)
+    {
+      now += 25ms;
+      interpolator.Update(now, apply);
+      ++frames;
+
+      // Playing out between received poses, behind the newest one
+      const double x = poses[1u].Pos().X();
+      EXPECT_LE(x, i);
+      EXPECT_GE(x, i - 2.0);
+    }
+  }
+  EXPECT_EQ(40, frames);
+
+  // Intermediate positions were produced, not just received ones
+  EXPECT_NE(0.0, poses[1u].Pos().X() - static_cast<int>(poses[1u].Pos().X()));
+
+  // Entity 2 didn't move again and is no longer updated
+  EXPECT_EQ(1u, interpolator.ActiveCount());
+  EXPECT_EQ(2u, interpolator.Size());
+
+  // Once the stream stops, entities settle at their newest pose without
+  // extrapolating
+  for (int f = 0; f < 100; ++f)
+  {
+    now += 25ms;
+    interpolator.Update(now, apply);
+  }
+  EXPECT_EQ(math::Pose3d(10, 0, 0, 0, 0, 0), poses[1u]);
+  EXPECT_EQ(0u, interpolator.ActiveCount());
+  EXPECT_LE(interpolator.PlayoutTime(), stamp);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseInterpolatorTest, OrderAndReset)
+{
+  PoseInterpolator interpolator;
+  interpolator.SetDelay(100ms);
+  interpolator.SetCapacity(3u);
+
+  interpolator.Add(1u, math::Pose3d(1, 0, 0, 0, 0, 0), 1000ms);
+  interpolator.Add(1u, math::Pose3d(2, 0, 0, 0, 0, 0), 1100ms);
+
+  // Out of order pose is dropped
+  interpolator.Add(1u, math::Pose3d(9, 0, 0, 0, 0, 0), 1050ms);
+
+  std::map<unsigned int, math::Pose3d> poses;
+  auto apply = [&poses](unsigned int _id, const math::Pose3d &_pose)
+  {
+    poses[_id] = _pose;
+  };
+  PoseInterpolator::Clock::time_point now;
+  interpolator.Update(now, apply);
+  EXPECT_EQ(1000ms, interpolator.PlayoutTime());
+  EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), poses[1u]);
+
+  // Erased entities are no longer updated
+  interpolator.Erase(1u);
+  EXPECT_EQ(0u, interpolator.Size());
+  EXPECT_EQ(0u, interpolator.ActiveCount());
+  poses.clear();
+  interpolator.Update(now + 10ms, apply);
+  EXPECT_TRUE(poses.empty());
+
+  // Time going backwards restarts the playout
+  interpolator.Add(2u, math::Pose3d(1, 0, 0, 0, 0, 0), 5000ms);
+  interpolator.Update(now + 20ms, apply);
+  interpolator.Add(2u, math::Pose3d(2, 0, 0, 0, 0, 0), 200ms);
+  EXPECT_EQ(1u, interpolator.Size());
+  interpolator.Update(now + 30ms, apply);
+  EXPECT_EQ(100ms, interpolator.PlayoutTime());
+  EXPECT_EQ(math::Pose3d(2, 0, 0, 0, 0, 0), poses[2u]);
+}
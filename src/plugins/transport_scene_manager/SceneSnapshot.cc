@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <QFile>
+#include <QSaveFile>
+
+#include <gz/common/Console.hh>
+
+#include "SceneSnapshot.hh"
+
+namespace gz::gui::plugins
+{
+/// \brief Magic bytes at the start of snapshot files
+static constexpr char kMagic[4] = {'G', 'Z', 'S', 'N'};
+
+/////////////////////////////////////////////////
+bool SceneSnapshot::Write(const std::string &_path,
+    const msgs::Scene &_scene)
+{
+  const std::string payload = _scene.SerializeAsString();
+  const std::uint64_t size = payload.size();
+  const std::uint64_t hash = Hash(payload.data(), payload.size());
+
+  char header[kHeaderSize];
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  std::memcpy(header + 4, &kFormatVersion, sizeof(kFormatVersion));
+  std::memcpy(header + 8, &size, sizeof(size));
+  std::memcpy(header + 16, &hash, sizeof(hash));
+
+  QSaveFile file(QString::fromStdString(_path));
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(header, kHeaderSize) != static_cast<qint64>(kHeaderSize) ||
+      file.write(payload.data(), static_cast<qint64>(payload.size())) !=
+      static_cast<qint64>(payload.size()) ||
+      !file.commit())
+  {
+    gzerr << "Failed to write scene snapshot [" << _path << "]: "
+          << file.errorString().toStdString() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SceneSnapshot::Read(const std::string &_path, msgs::Scene &_scene)
+{
+  QFile file(QString::fromStdString(_path));
+  if (!file.exists())
+    return false;
+
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    gzwarn << "Failed to open scene snapshot [" << _path << "]: "
+           << file.errorString().toStdString() << std::endl;
+    return false;
+  }
+
+  const qint64 fileSize = file.size();
+  if (fileSize < static_cast<qint64>(kHeaderSize))
+  {
+    gzwarn << "Ignoring truncated scene snapshot [" << _path << "]"
+           << std::endl;
+    return false;
+  }
+
+  // The mapping is released when the file is closed
+  const uchar *data = file.map(0, fileSize);
+  if (nullptr == data)
+  {
+    gzwarn << "Failed to map scene snapshot [" << _path << "]: "
+           << file.errorString().toStdString() << std::endl;
+    return false;
+  }
+
+  std::uint32_t version{0u};
+  std::uint64_t size{0u};
+  std::uint64_t hash{0u};
+  std::memcpy(&version, data + 4, sizeof(version));
+  std::memcpy(&size, data + 8, sizeof(size));
+  std::memcpy(&hash, data + 16, sizeof(hash));
+  const uchar *payload = data + kHeaderSize;
+
+  if (std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+      version != kFormatVersion)
+  {
+    gzwarn << "Ignoring scene snapshot [" << _path << "] with unknown format"
+           << std::endl;
+    return false;
+  }
+
+  if (size != static_cast<std::uint64_t>(fileSize) - kHeaderSize ||
+      hash != Hash(payload, size) ||
+      !_scene.ParseFromArray(payload, static_cast<int>(size)))
+  {
+    gzwarn << "Ignoring corrupted scene snapshot [" << _path << "]"
+           << std::endl;
+    _scene.Clear();
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string SceneSnapshot::Version(const msgs::Scene &_scene)
+{
+  for (const auto &data : _scene.header().data())
+  {
+    if (data.key() == "version" && data.value_size() > 0)
+      return data.value(0);
+  }
+
+  // The header changes with every response, e.g. its stamp, so only the
+  // contents are hashed
+  msgs::Scene contents = _scene;
+  contents.clear_header();
+  const std::string payload = contents.SerializeAsString();
+  std::ostringstream stream;
+  stream << "hash:" << std::hex << std::setw(16) << std::setfill('0')
+         << Hash(payload.data(), payload.size());
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+std::uint64_t SceneSnapshot::Hash(const void *_data, std::size_t _size)
+{
+  const auto *bytes = static_cast<const unsigned char *>(_data);
+  std::uint64_t hash{14695981039346656037ull};
+  for (std::size_t i = 0u; i < _size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+}  // namespace gz::gui::plugins
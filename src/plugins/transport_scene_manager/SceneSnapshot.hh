@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SCENESNAPSHOT_HH_
+#define GZ_GUI_PLUGINS_SCENESNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <gz/msgs/scene.pb.h>
+
+#ifndef _WIN32
+#  define SceneSnapshot_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define SceneSnapshot_EXPORTS_API __declspec(dllexport)
+#  else
+#    define SceneSnapshot_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Reads and writes scene msgs to snapshot files, so the last
+  /// scene received can be shown right away on the next launch.
+  ///
+  /// A snapshot file holds a fixed size header followed by the serialized
+  /// scene msg:
+  ///
+  /// * 4 bytes: "GZSN"
+  /// * 4 bytes: format version
+  /// * 8 bytes: scene msg size
+  /// * 8 bytes: FNV-1a hash of the scene msg
+  ///
+  /// Integers are stored in the machine's byte order. Files are memory
+  /// mapped when read, and rejected if any of the header fields doesn't
+  /// match.
+  class SceneSnapshot_EXPORTS_API SceneSnapshot
+  {
+    /// \brief Current file format version.
+    public: static constexpr std::uint32_t kFormatVersion{1u};
+
+    /// \brief Size of the file header.
+    public: static constexpr std::size_t kHeaderSize{24u};
+
+    /// \brief Write a snapshot file, replacing any existing file only once
+    /// it's completely written.
+    /// \param[in] _path File path.
+    /// \param[in] _scene Scene msg.
+    /// \return True if successful.
+    public: static bool Write(const std::string &_path,
+                              const msgs::Scene &_scene);
+
+    /// \brief Read a snapshot file.
+    /// \param[in] _path File path.
+    /// \param[out] _scene Scene msg.
+    /// \return True if the file exists and is valid.
+    public: static bool Read(const std::string &_path, msgs::Scene &_scene);
+
+    /// \brief Get the version of a scene, used to check if a snapshot is
+    /// still up to date. It's the value of the scene msg's "version" header
+    /// data entry if the server provides one, and a hash of the msg
+    /// without its header otherwise.
+    /// \param[in] _scene Scene msg.
+    /// \return Version.
+    public: static std::string Version(const msgs::Scene &_scene);
+
+    /// \brief Compute the 64 bit FNV-1a hash of some data.
+    /// \param[in] _data Data.
+    /// \param[in] _size Data size in bytes.
+    /// \return Hash.
+    public: static std::uint64_t Hash(const void *_data, std::size_t _size);
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_SCENESNAPSHOT_HH_
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/msgs/scene.pb.h>
+
+#include "SceneSnapshot.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+class SceneSnapshotTest : public ::testing::Test
+{
+  // Documentation inherited
+  protected: void SetUp() override
+  {
+    this->dir = common::createTempDirectory("scene_snapshot",
+        common::tempDirectoryPath());
+    ASSERT_FALSE(this->dir.empty());
+    this->path = common::joinPaths(this->dir, "scene.snapshot");
+
+    this->scene.set_name("cached");
+    auto model = this->scene.add_model();
+    model->set_name("box");
+    model->set_id(10u);
+    auto light = this->scene.add_light();
+    light->set_name("sun");
+    light->set_id(20u);
+  }
+
+  // Documentation inherited
+  protected: void TearDown() override
+  {
+    common::removeAll(this->dir);
+  }
+
+  /// \brief Read the whole snapshot file
+  /// \return File contents
+  protected: std::string ReadFile() const
+  {
+    std::ifstream in(this->path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  }
+
+  /// \brief Replace the snapshot file
+  /// \param[in] _contents File contents
+  protected: void WriteFile(const std::string &_contents) const
+  {
+    std::ofstream out(this->path, std::ios::binary | std::ios::trunc);
+    out << _contents;
+  }
+
+  /// \brief Temporary directory
+  protected: std::string dir;
+
+  /// \brief Snapshot file path
+  protected: std::string path;
+
+  /// \brief Scene written to the snapshot
+  protected: msgs::Scene scene;
+};
+
+/////////////////////////////////////////////////
+TEST_F(SceneSnapshotTest, RoundTrip)
+{
+  msgs::Scene read;
+  EXPECT_FALSE(SceneSnapshot::Read(this->path, read));
+
+  ASSERT_TRUE(SceneSnapshot::Write(this->path, this->scene));
+  ASSERT_TRUE(SceneSnapshot::Read(this->path, read));
+  EXPECT_EQ(this->scene.SerializeAsString(), read.SerializeAsString());
+  EXPECT_EQ(SceneSnapshot::kHeaderSize + this->scene.ByteSizeLong(),
+      this->ReadFile().size());
+
+  // Overwriting replaces the previous snapshot
+  this->scene.mutable_model(0)->set_name("sphere");
+  ASSERT_TRUE(SceneSnapshot::Write(this->path, this->scene));
+  ASSERT_TRUE(SceneSnapshot::Read(this->path, read));
+  EXPECT_EQ("sphere", read.model(0).name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneSnapshotTest, Invalid)
+{
+  ASSERT_TRUE(SceneSnapshot::Write(this->path, this->scene));
+  const std::string valid = this->ReadFile();
+  msgs::Scene read;
+
+  // Truncated header or payload
+  this->WriteFile(valid.substr(0, SceneSnapshot::kHeaderSize - 1u));
+  EXPECT_FALSE(SceneSnapshot::Read(this->path, read));
+  this->WriteFile(valid.substr(0, valid.size() - 1u));
+  EXPECT_FALSE(SceneSnapshot::Read(this->path, read));
+
+  // Unknown magic or format version
+  std::string corrupted = valid;
+  corrupted[0] = 'X';
+  this->WriteFile(corrupted);
+  EXPECT_FALSE(SceneSnapshot::Read(this->path, read));
+  corrupted = valid;
+  ++corrupted[4];
+  this->WriteFile(corrupted);
+  EXPECT_FALSE(SceneSnapshot::Read(this->path, read));
+
+  // Corrupted payload
+  corrupted = valid;
+  corrupted.back() ^= 0x01;
+  this->WriteFile(corrupted);
+  EXPECT_FALSE(SceneSnapshot::Read(this->path, read));
+  EXPECT_EQ(0, read.model_size());
+
+  this->WriteFile(valid);
+  EXPECT_TRUE(SceneSnapshot::Read(this->path, read));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneSnapshotTest, Version)
+{
+  // Without a server version, scenes are compared by contents
+  msgs::Scene other = this->scene;
+  EXPECT_EQ(SceneSnapshot::Version(this->scene),
+      SceneSnapshot::Version(other));
+
+  // The header isn't part of the contents
+  other.mutable_header()->mutable_stamp()->set_sec(12);
+  EXPECT_EQ(SceneSnapshot::Version(this->scene),
+      SceneSnapshot::Version(other));
+  other.mutable_model(0)->set_id(11u);
+  EXPECT_NE(SceneSnapshot::Version(this->scene),
+      SceneSnapshot::Version(other));
+
+  // The server version takes precedence
+  auto data = this->scene.mutable_header()->add_data();
+  data->set_key("version");
+  data->add_value("42");
+  EXPECT_EQ("42", SceneSnapshot::Version(this->scene));
+  *other.mutable_header() = this->scene.header();
+  EXPECT_EQ("42", SceneSnapshot::Version(other));
+
+  EXPECT_NE(SceneSnapshot::Hash("a", 1u), SceneSnapshot::Hash("b", 1u));
+}
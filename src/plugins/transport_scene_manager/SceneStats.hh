@@ -0,0 +1,367 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SCENESTATS_HH_
+#define GZ_GUI_PLUGINS_SCENESTATS_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/any.pb.h>
+#include <gz/msgs/param.pb.h>
+
+namespace gz::gui::plugins
+{
+  /// \brief Histogram with fixed buckets, cheap enough to update every
+  /// frame.
+  class Histogram
+  {
+    /// \brief Constructor
+    /// \param[in] _bounds Upper bounds of the buckets, in increasing order.
+    /// Values above the last bound go in an extra overflow bucket.
+    public: explicit Histogram(std::vector<double> _bounds)
+      : bounds(std::move(_bounds)), counts(this->bounds.size() + 1u, 0u)
+    {
+    }
+
+    /// \brief Add a value.
+    /// \param[in] _value Value.
+    public: void Add(double _value)
+    {
+      const auto bucket = std::lower_bound(this->bounds.begin(),
+          this->bounds.end(), _value) - this->bounds.begin();
+      ++this->counts[static_cast<std::size_t>(bucket)];
+      ++this->count;
+      this->sum += _value;
+      this->max = std::max(this->max, _value);
+    }
+
+    /// \brief Number of values added since the last reset.
+    /// \return Number of values.
+    public: std::uint64_t Count() const
+    {
+      return this->count;
+    }
+
+    /// \brief Mean of the values.
+    /// \return Mean, 0 if there are no values.
+    public: double Mean() const
+    {
+      return this->count > 0u ? this->sum / this->count : 0.0;
+    }
+
+    /// \brief Largest value.
+    /// \return Largest value, 0 if there are no values.
+    public: double Max() const
+    {
+      return this->count > 0u ? this->max : 0.0;
+    }
+
+    /// \brief Estimate a percentile as the upper bound of the bucket it
+    /// falls in.
+    /// \param[in] _fraction Percentile, from 0 to 1.
+    /// \return Upper bound of the bucket, capped to the largest value. 0 if
+    /// there are no values.
+    public: double Percentile(double _fraction) const
+    {
+      if (this->count == 0u)
+        return 0.0;
+
+      const double rank = std::clamp(_fraction, 0.0, 1.0) * this->count;
+      std::uint64_t seen{0u};
+      for (std::size_t i = 0u; i < this->bounds.size(); ++i)
+      {
+        seen += this->counts[i];
+        if (seen > 0u && static_cast<double>(seen) >= rank)
+          return std::min(this->bounds[i], this->max);
+      }
+      return this->max;
+    }
+
+    /// \brief Bucket upper bounds.
+    /// \return Bounds.
+    public: const std::vector<double> &Bounds() const
+    {
+      return this->bounds;
+    }
+
+    /// \brief Number of values in each bucket, including the overflow
+    /// bucket last.
+    /// \return Bucket counts.
+    public: const std::vector<std::uint64_t> &Counts() const
+    {
+      return this->counts;
+    }
+
+    /// \brief Remove all values.
+    public: void Reset()
+    {
+      std::fill(this->counts.begin(), this->counts.end(), 0u);
+      this->count = 0u;
+      this->sum = 0.0;
+      this->max = -std::numeric_limits<double>::infinity();
+    }
+
+    /// \brief Bucket upper bounds.
+    private: std::vector<double> bounds;
+
+    /// \brief Number of values in each bucket.
+    private: std::vector<std::uint64_t> counts;
+
+    /// \brief Number of values.
+    private: std::uint64_t count{0u};
+
+    /// \brief Sum of the values.
+    private: double sum{0.0};
+
+    /// \brief Largest value.
+    private: double max{-std::numeric_limits<double>::infinity()};
+  };
+
+  /// \brief Scene synchronization statistics collected on the render
+  /// thread over a reporting period.
+  class SceneStats
+  {
+    /// \brief Event counters.
+    public: enum class Counter
+    {
+      /// \brief Pose messages received
+      kPoseMsgs,
+
+      /// \brief Poses written to the scene
+      kPosesApplied,
+
+      /// \brief Poses skipped because the entity didn't move
+      kPosesSkipped,
+
+      /// \brief Poses of unknown entities discarded
+      kPosesDropped,
+
+      /// \brief Scene messages received
+      kSceneMsgs,
+
+      /// \brief Scene messages merged into another before being applied
+      kSceneMsgsMerged,
+
+      /// \brief Entities created
+      kEntitiesLoaded,
+
+      /// \brief Number of counters
+      kCount
+    };
+
+    /// \brief Histograms.
+    public: enum class Metric
+    {
+      /// \brief Time in milliseconds from receiving a pose message to
+      /// applying it
+      kPoseAge,
+
+      /// \brief Time in milliseconds spent creating entities on a frame
+      kFrameLoadTime,
+
+      /// \brief Time in milliseconds from queueing a scene to having all
+      /// its entities created
+      kSceneLoadTime,
+
+      /// \brief Number of entities waiting to be created, sampled every
+      /// frame
+      kLoadQueueDepth,
+
+      /// \brief Number of histograms
+      kCount
+    };
+
+    /// \brief Constructor
+    public: SceneStats()
+      : histograms{
+          Histogram({1, 2, 5, 10, 20, 50, 100, 200, 500, 1000}),
+          Histogram({1, 2, 5, 10, 20, 50, 100}),
+          Histogram({10, 50, 100, 500, 1000, 5000, 10000, 30000}),
+          Histogram({0, 10, 100, 1000, 10000, 100000})}
+    {
+    }
+
+    /// \brief Count events.
+    /// \param[in] _counter Counter.
+    /// \param[in] _n Number of events.
+    public: void Add(Counter _counter, std::uint64_t _n = 1u)
+    {
+      this->counters[static_cast<std::size_t>(_counter)] += _n;
+    }
+
+    /// \brief Add a value to a histogram.
+    /// \param[in] _metric Histogram.
+    /// \param[in] _value Value.
+    public: void Add(Metric _metric, double _value)
+    {
+      this->histograms[static_cast<std::size_t>(_metric)].Add(_value);
+    }
+
+    /// \brief Get a counter.
+    /// \param[in] _counter Counter.
+    /// \return Number of events since the last reset.
+    public: std::uint64_t Value(Counter _counter) const
+    {
+      return this->counters[static_cast<std::size_t>(_counter)];
+    }
+
+    /// \brief Get a histogram.
+    /// \param[in] _metric Histogram.
+    /// \return Histogram.
+    public: const Histogram &Values(Metric _metric) const
+    {
+      return this->histograms[static_cast<std::size_t>(_metric)];
+    }
+
+    /// \brief Start a new reporting period.
+    public: void Reset()
+    {
+      this->counters.fill(0u);
+      for (auto &histogram : this->histograms)
+        histogram.Reset();
+    }
+
+    /// \brief Name used for a counter in reports.
+    /// \param[in] _counter Counter.
+    /// \return Name.
+    public: static const char *Name(Counter _counter)
+    {
+      static constexpr std::array<const char *,
+          static_cast<std::size_t>(Counter::kCount)> kNames{
+          "pose_msgs", "poses_applied", "poses_skipped", "poses_dropped",
+          "scene_msgs", "scene_msgs_merged", "entities_loaded"};
+      return kNames[static_cast<std::size_t>(_counter)];
+    }
+
+    /// \brief Name used for a histogram in reports.
+    /// \param[in] _metric Histogram.
+    /// \return Name.
+    public: static const char *Name(Metric _metric)
+    {
+      static constexpr std::array<const char *,
+          static_cast<std::size_t>(Metric::kCount)> kNames{
+          "pose_age_ms", "frame_load_time_ms", "scene_load_time_ms",
+          "load_queue_depth"};
+      return kNames[static_cast<std::size_t>(_metric)];
+    }
+
+    /// \brief Fill a param msg with the statistics of the period.
+    ///
+    /// Each counter is an int param named after it, plus a double
+    /// "<name>_per_sec" param. Each histogram is a child param with
+    /// "name", "count", "mean", "p50", "p90", "p99" and "max" params, and
+    /// "le_<bound>" params with the number of values in each bucket,
+    /// "le_inf" for the overflow bucket.
+    /// \param[in] _period Length of the period in seconds.
+    /// \param[out] _msg Param msg.
+    public: void Fill(double _period, msgs::Param &_msg) const
+    {
+      auto &params = *_msg.mutable_params();
+      params["period"].set_type(msgs::Any::DOUBLE);
+      params["period"].set_double_value(_period);
+      for (std::size_t i = 0u; i < this->counters.size(); ++i)
+      {
+        const std::string name = Name(static_cast<Counter>(i));
+        params[name].set_type(msgs::Any::INT32);
+        params[name].set_int_value(static_cast<std::int32_t>(std::min<
+            std::uint64_t>(this->counters[i],
+            std::numeric_limits<std::int32_t>::max())));
+        params[name + "_per_sec"].set_type(msgs::Any::DOUBLE);
+        params[name + "_per_sec"].set_double_value(
+            _period > 0.0 ? this->counters[i] / _period : 0.0);
+      }
+
+      for (std::size_t i = 0u; i < this->histograms.size(); ++i)
+      {
+        const auto &histogram = this->histograms[i];
+        auto &child = *_msg.add_children()->mutable_params();
+        child["name"].set_type(msgs::Any::STRING);
+        child["name"].set_string_value(Name(static_cast<Metric>(i)));
+        child["count"].set_type(msgs::Any::INT32);
+        child["count"].set_int_value(
+            static_cast<std::int32_t>(histogram.Count()));
+
+        const std::array<std::pair<const char *, double>, 5> values{{
+            {"mean", histogram.Mean()},
+            {"p50", histogram.Percentile(0.5)},
+            {"p90", histogram.Percentile(0.9)},
+            {"p99", histogram.Percentile(0.99)},
+            {"max", histogram.Max()}}};
+        for (const auto &[key, value] : values)
+        {
+          child[key].set_type(msgs::Any::DOUBLE);
+          child[key].set_double_value(value);
+        }
+
+        for (std::size_t b = 0u; b < histogram.Counts().size(); ++b)
+        {
+          std::ostringstream key;
+          key << "le_";
+          if (b < histogram.Bounds().size())
+            key << histogram.Bounds()[b];
+          else
+            key << "inf";
+          child[key.str()].set_type(msgs::Any::INT32);
+          child[key.str()].set_int_value(
+              static_cast<std::int32_t>(histogram.Counts()[b]));
+        }
+      }
+    }
+
+    /// \brief Short human readable summary of the period.
+    /// \param[in] _period Length of the period in seconds.
+    /// \return One line per counter and histogram.
+    public: std::string Summary(double _period) const
+    {
+      std::ostringstream stream;
+      stream << std::fixed << std::setprecision(1);
+      for (std::size_t i = 0u; i < this->counters.size(); ++i)
+      {
+        stream << Name(static_cast<Counter>(i)) << ": "
+               << (_period > 0.0 ? this->counters[i] / _period : 0.0)
+               << "/s\n";
+      }
+      for (std::size_t i = 0u; i < this->histograms.size(); ++i)
+      {
+        const auto &histogram = this->histograms[i];
+        stream << Name(static_cast<Metric>(i)) << ": mean "
+               << histogram.Mean() << ", p90 " << histogram.Percentile(0.9)
+               << ", max " << histogram.Max() << "\n";
+      }
+      return stream.str();
+    }
+
+    /// \brief Event counters.
+    private: std::array<std::uint64_t,
+        static_cast<std::size_t>(Counter::kCount)> counters{};
+
+    /// \brief Histograms.
+    private: std::array<Histogram,
+        static_cast<std::size_t>(Metric::kCount)> histograms;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_SCENESTATS_HH_
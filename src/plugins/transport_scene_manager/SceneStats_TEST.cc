@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/param.pb.h>
+
+#include "SceneStats.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(SceneStatsTest, Histogram)
+{
+  Histogram histogram({1.0, 10.0, 100.0});
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.Mean());
+  EXPECT_DOUBLE_EQ(0.0, histogram.Percentile(0.5));
+
+  for (int i = 0; i < 8; ++i)
+    histogram.Add(0.5);
+  histogram.Add(5.0);
+  histogram.Add(500.0);
+  EXPECT_EQ(10u, histogram.Count());
+  ASSERT_EQ(4u, histogram.Counts().size());
+  EXPECT_EQ(8u, histogram.Counts()[0]);
+  EXPECT_EQ(1u, histogram.Counts()[1]);
+  EXPECT_EQ(0u, histogram.Counts()[2]);
+  EXPECT_EQ(1u, histogram.Counts()[3]);
+  EXPECT_DOUBLE_EQ(50.9, histogram.Mean());
+  EXPECT_DOUBLE_EQ(500.0, histogram.Max());
+
+  // Percentiles are bucket bounds, capped to the largest value
+  EXPECT_DOUBLE_EQ(1.0, histogram.Percentile(0.5));
+  EXPECT_DOUBLE_EQ(10.0, histogram.Percentile(0.9));
+  EXPECT_DOUBLE_EQ(500.0, histogram.Percentile(0.99));
+
+  histogram.Reset();
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_EQ(0u, histogram.Counts()[0]);
+  histogram.Add(0.5);
+  EXPECT_DOUBLE_EQ(0.5, histogram.Percentile(1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(SceneStatsTest, Fill)
+{
+  SceneStats stats;
+  stats.Add(SceneStats::Counter::kPosesApplied, 20u);
+  stats.Add(SceneStats::Counter::kSceneMsgs);
+  stats.Add(SceneStats::Metric::kPoseAge, 3.0);
+  EXPECT_EQ(20u, stats.Value(SceneStats::Counter::kPosesApplied));
+  EXPECT_EQ(1u, stats.Values(SceneStats::Metric::kPoseAge).Count());
+
+  msgs::Param msg;
+  stats.Fill(2.0, msg);
+  EXPECT_DOUBLE_EQ(2.0, msg.params().at("period").double_value());
+  EXPECT_EQ(20, msg.params().at("poses_applied").int_value());
+  EXPECT_DOUBLE_EQ(10.0,
+      msg.params().at("poses_applied_per_sec").double_value());
+  EXPECT_EQ(1, msg.params().at("scene_msgs").int_value());
+  EXPECT_EQ(0, msg.params().at("poses_dropped").int_value());
+
+  ASSERT_EQ(static_cast<int>(SceneStats::Metric::kCount),
+      msg.children_size());
+  const auto &age = msg.children(0).params();
+  EXPECT_EQ("pose_age_ms", age.at("name").string_value());
+  EXPECT_EQ(1, age.at("count").int_value());
+  EXPECT_DOUBLE_EQ(3.0, age.at("max").double_value());
+  EXPECT_EQ(1, age.at("le_5").int_value());
+  EXPECT_EQ(0, age.at("le_inf").int_value());
+
+  EXPECT_FALSE(stats.Summary(2.0).empty());
+
+  stats.Reset();
+  EXPECT_EQ(0u, stats.Value(SceneStats::Counter::kPosesApplied));
+  EXPECT_EQ(0u, stats.Values(SceneStats::Metric::kPoseAge).Count());
+}
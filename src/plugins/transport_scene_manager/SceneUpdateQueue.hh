@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SCENEUPDATEQUEUE_HH_
+#define GZ_GUI_PLUGINS_SCENEUPDATEQUEUE_HH_
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/model.pb.h>
+#include <gz/msgs/scene.pb.h>
+
+namespace gz::gui::plugins
+{
+  /// \brief A scene msg waiting to be applied by the render thread
+  struct SceneUpdate
+  {
+    /// \brief How the msg is applied
+    enum class Kind
+    {
+      /// \brief Only add entities which don't exist yet
+      kAdd,
+
+      /// \brief Delete the entities listed in the header, then add or
+      /// replace the msg's entities
+      kDelta,
+
+      /// \brief Full scene replacing everything loaded so far. Top level
+      /// entities which didn't change are kept.
+      kSnapshot
+    };
+
+    /// \brief Scene msg
+    msgs::Scene msg;
+
+    /// \brief How the msg is applied
+    Kind kind{Kind::kAdd};
+  };
+
+  /// \brief Queue of scene updates which merges updates received between
+  /// two frames, so entities published several times are only loaded once.
+  ///
+  /// Consecutive updates of the same kind are merged into one, keeping the
+  /// last version of each top level model and light, and the other fields
+  /// of the last msg. A snapshot replaces everything queued before it.
+  /// Updates are moved in and out, never copied. The queue isn't thread
+  /// safe.
+  class SceneUpdateQueue
+  {
+    /// \brief Queue an update, merging it with the last one if possible.
+    /// \param[in] _update Update to queue.
+    public: void Push(SceneUpdate &&_update)
+    {
+      if (_update.kind == SceneUpdate::Kind::kSnapshot)
+      {
+        this->merged += this->updates.size();
+        this->updates.clear();
+      }
+      else if (!this->updates.empty() &&
+               this->updates.back().kind == _update.kind &&
+               Merge(this->updates.back(), _update))
+      {
+        ++this->merged;
+        return;
+      }
+      this->updates.push_back(std::move(_update));
+    }
+
+    /// \brief Take all queued updates, in order.
+    /// \return Updates.
+    public: std::vector<SceneUpdate> Take()
+    {
+      std::vector<SceneUpdate> taken;
+      taken.swap(this->updates);
+      return taken;
+    }
+
+    /// \brief Number of queued updates.
+    /// \return Number of updates.
+    public: std::size_t Size() const
+    {
+      return this->updates.size();
+    }
+
+    /// \brief Total number of updates merged into another one or dropped
+    /// because of a snapshot.
+    /// \return Number of updates.
+    public: std::size_t MergedCount() const
+    {
+      return this->merged;
+    }
+
+    /// \brief Merge an older update into a newer one of the same kind. The
+    /// result is left in _older.
+    /// \param[in, out] _older Queued update, replaced by the merged one.
+    /// \param[in, out] _newer Update being queued, emptied if merged.
+    /// \return False if the updates can't be merged because the newer one
+    /// deletes an entity nested in the older one.
+    public: static bool Merge(SceneUpdate &_older, SceneUpdate &_newer)
+    {
+      std::unordered_set<unsigned int> deleted;
+      if (_newer.kind == SceneUpdate::Kind::kDelta)
+      {
+        for (const auto &data : _newer.msg.header().data())
+        {
+          if (data.key() != "deleted")
+            continue;
+          for (const auto &value : data.value())
+          {
+            try
+            {
+              deleted.insert(static_cast<unsigned int>(std::stoul(value)));
+            }
+            catch (...)
+            {
+              // Invalid ids are reported when the update is applied
+            }
+          }
+        }
+
+        // Deleting a nested entity after its model was loaded can't be
+        // expressed by a single update
+        for (const auto &model : _older.msg.model())
+        {
+          if (ContainsNested(model, deleted))
+            return false;
+        }
+      }
+
+      // Entities of the newer msg win, the older msg's other entities are
+      // kept unless the newer msg deletes them
+      std::unordered_set<unsigned int> newerIds(deleted);
+      for (const auto &model : _newer.msg.model())
+        newerIds.insert(model.id());
+      for (const auto &light : _newer.msg.light())
+        newerIds.insert(light.id());
+
+      for (auto &model : *_older.msg.mutable_model())
+      {
+        if (newerIds.count(model.id()) == 0u)
+          _newer.msg.add_model()->Swap(&model);
+      }
+      for (auto &light : *_older.msg.mutable_light())
+      {
+        if (newerIds.count(light.id()) == 0u)
+          _newer.msg.add_light()->Swap(&light);
+      }
+
+      // Deletions of both, in order
+      if (_newer.kind == SceneUpdate::Kind::kDelta)
+      {
+        msgs::Header_Map *olderDeleted{nullptr};
+        for (auto &data : *_older.msg.mutable_header()->mutable_data())
+        {
+          if (data.key() == "deleted")
+            olderDeleted = &data;
+        }
+        if (nullptr != olderDeleted && olderDeleted->value_size() > 0)
+        {
+          msgs::Header_Map *newerDeleted{nullptr};
+          for (auto &data : *_newer.msg.mutable_header()->mutable_data())
+          {
+            if (data.key() == "deleted")
+              newerDeleted = &data;
+          }
+          if (nullptr == newerDeleted)
+          {
+            newerDeleted = _newer.msg.mutable_header()->add_data();
+            newerDeleted->set_key("deleted");
+          }
+          olderDeleted->mutable_value()->MergeFrom(newerDeleted->value());
+          newerDeleted->mutable_value()->Swap(olderDeleted->mutable_value());
+        }
+      }
+
+      _older.msg.Swap(&_newer.msg);
+      _newer.msg.Clear();
+      return true;
+    }
+
+    /// \brief Whether a model contains one of the given entities below its
+    /// top level.
+    /// \param[in] _model Model msg.
+    /// \param[in] _ids Entity ids.
+    /// \return True if a link, visual, light or nested model is in _ids.
+    public: static bool ContainsNested(const msgs::Model &_model,
+        const std::unordered_set<unsigned int> &_ids)
+    {
+      if (_ids.empty())
+        return false;
+
+      for (const auto &link : _model.link())
+      {
+        if (_ids.count(link.id()) > 0u)
+          return true;
+        for (const auto &visual : link.visual())
+        {
+          if (_ids.count(visual.id()) > 0u)
+            return true;
+        }
+        for (const auto &light : link.light())
+        {
+          if (_ids.count(light.id()) > 0u)
+            return true;
+        }
+      }
+      for (const auto &model : _model.model())
+      {
+        if (_ids.count(model.id()) > 0u || ContainsNested(model, _ids))
+          return true;
+      }
+      return false;
+    }
+
+    /// \brief Queued updates, oldest first.
+    private: std::vector<SceneUpdate> updates;
+
+    /// \brief Number of updates merged or dropped.
+    private: std::size_t merged{0u};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_SCENEUPDATEQUEUE_HH_
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/scene.pb.h>
+
+#include "SceneUpdateQueue.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Create a scene update
+/// \param[in] _kind Update kind
+/// \param[in] _models Ids and names of top level models
+/// \param[in] _deleted Ids of deleted entities
+/// \return Update
+static SceneUpdate makeUpdate(SceneUpdate::Kind _kind,
+    const std::vector<std::pair<unsigned int, std::string>> &_models,
+    const std::vector<std::string> &_deleted = {})
+{
+  SceneUpdate update;
+  update.kind = _kind;
+  for (const auto &[id, name] : _models)
+  {
+    auto model = update.msg.add_model();
+    model->set_id(id);
+    model->set_name(name);
+  }
+  if (!_deleted.empty())
+  {
+    auto data = update.msg.mutable_header()->add_data();
+    data->set_key("deleted");
+    for (const auto &id : _deleted)
+      data->add_value(id);
+  }
+  return update;
+}
+
+/// \brief Get the name of a model in a scene msg
+/// \param[in] _msg Scene msg
+/// \param[in] _id Model id
+/// \return Model name, empty if there's no model with that id
+static std::string modelName(const msgs::Scene &_msg, unsigned int _id)
+{
+  for (const auto &model : _msg.model())
+  {
+    if (model.id() == _id)
+      return model.name();
+  }
+  return std::string();
+}
+
+/////////////////////////////////////////////////
+TEST(SceneUpdateQueueTest, MergeAdds)
+{
+  SceneUpdateQueue queue;
+  queue.Push(makeUpdate(SceneUpdate::Kind::kAdd, {{1u, "a"}, {2u, "b"}}));
+  queue.Push(makeUpdate(SceneUpdate::Kind::kAdd, {{2u, "b2"}, {3u, "c"}}));
+  auto third = makeUpdate(SceneUpdate::Kind::kAdd, {{3u, "c2"}});
+  third.msg.set_name("latest");
+  queue.Push(std::move(third));
+  EXPECT_EQ(1u, queue.Size());
+  EXPECT_EQ(2u, queue.MergedCount());
+
+  // Each model once, the last version wins
+  auto updates = queue.Take();
+  EXPECT_EQ(0u, queue.Size());
+  ASSERT_EQ(1u, updates.size());
+  const auto &msg = updates[0].msg;
+  EXPECT_EQ(3, msg.model_size());
+  EXPECT_EQ("a", modelName(msg, 1u));
+  EXPECT_EQ("b2", modelName(msg, 2u));
+  EXPECT_EQ("c2", modelName(msg, 3u));
+  EXPECT_EQ("latest", msg.name());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneUpdateQueueTest, MergeDeltas)
+{
+  SceneUpdateQueue queue;
+  queue.Push(makeUpdate(SceneUpdate::Kind::kDelta, {{1u, "a"}, {2u, "b"}},
+      {"10"}));
+  queue.Push(makeUpdate(SceneUpdate::Kind::kDelta, {{3u, "c"}}, {"2", "11"}));
+  ASSERT_EQ(1u, queue.Size());
+
+  // Models deleted by a later delta are dropped, deletions are kept
+  auto updates = queue.Take();
+  const auto &msg = updates[0].msg;
+  EXPECT_EQ(2, msg.model_size());
+  EXPECT_EQ("a", modelName(msg, 1u));
+  EXPECT_EQ("", modelName(msg, 2u));
+  EXPECT_EQ("c", modelName(msg, 3u));
+  ASSERT_EQ(1, msg.header().data_size());
+  const auto &deleted = msg.header().data(0);
+  EXPECT_EQ("deleted", deleted.key());
+  ASSERT_EQ(3, deleted.value_size());
+  EXPECT_EQ("10", deleted.value(0));
+  EXPECT_EQ("2", deleted.value(1));
+  EXPECT_EQ("11", deleted.value(2));
+
+  // Deleting part of a queued model can't be merged
+  auto nested = makeUpdate(SceneUpdate::Kind::kDelta, {{1u, "a"}});
+  nested.msg.mutable_model(0)->add_link()->set_id(5u);
+  queue.Push(std::move(nested));
+  queue.Push(makeUpdate(SceneUpdate::Kind::kDelta, {}, {"5"}));
+  EXPECT_EQ(2u, queue.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneUpdateQueueTest, Order)
+{
+  SceneUpdateQueue queue;
+
+  // Different kinds aren't merged
+  queue.Push(makeUpdate(SceneUpdate::Kind::kAdd, {{1u, "a"}}));
+  queue.Push(makeUpdate(SceneUpdate::Kind::kDelta, {{2u, "b"}}));
+  queue.Push(makeUpdate(SceneUpdate::Kind::kAdd, {{3u, "c"}}));
+  EXPECT_EQ(3u, queue.Size());
+
+  // A snapshot replaces everything before it, and later updates apply on
+  // top of it
+  queue.Push(makeUpdate(SceneUpdate::Kind::kSnapshot, {{4u, "d"}}));
+  queue.Push(makeUpdate(SceneUpdate::Kind::kDelta, {{5u, "e"}}));
+  auto updates = queue.Take();
+  ASSERT_EQ(2u, updates.size());
+  EXPECT_EQ(SceneUpdate::Kind::kSnapshot, updates[0].kind);
+  EXPECT_EQ("d", modelName(updates[0].msg, 4u));
+  EXPECT_EQ(SceneUpdate::Kind::kDelta, updates[1].kind);
+  EXPECT_EQ(3u, queue.MergedCount());
+}
@@ -0,0 +1,690 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "SpatialIndex.hh"
+
+namespace gz::gui::plugins
+{
+/// \brief Corner of a box
+using Corner = std::array<double, 3>;
+
+/// \brief Node of the tree. Leaves hold one entity each, inner nodes always
+/// have two children.
+struct TreeNode
+{
+  /// \brief Minimum corner of the enlarged box of a leaf, or of the union
+  /// of the children's boxes
+  Corner min{};
+
+  /// \brief Maximum corner of the box
+  Corner max{};
+
+  /// \brief Minimum corner of the entity's bounds, leaves only
+  Corner exactMin{};
+
+  /// \brief Maximum corner of the entity's bounds, leaves only
+  Corner exactMax{};
+
+  /// \brief Entity id, leaves only
+  std::uint64_t id{0u};
+
+  /// \brief Index of the parent node, -1 for the root
+  int parent{-1};
+
+  /// \brief Index of the first child, -1 for leaves
+  int left{-1};
+
+  /// \brief Index of the second child, -1 for leaves
+  int right{-1};
+
+  /// \brief Height of the subtree, 0 for leaves, -1 for free nodes
+  int height{-1};
+
+  /// \brief Whether the node is a leaf
+  /// \return True for leaves
+  bool Leaf() const
+  {
+    return this->left < 0;
+  }
+};
+
+/// \brief Surface area of a box, the cost of visiting it in a query
+/// \param[in] _min Minimum corner
+/// \param[in] _max Maximum corner
+/// \return Surface area
+static double surfaceArea(const Corner &_min, const Corner &_max)
+{
+  const double dx = _max[0] - _min[0];
+  const double dy = _max[1] - _min[1];
+  const double dz = _max[2] - _min[2];
+  return 2.0 * (dx * dy + dy * dz + dz * dx);
+}
+
+/// \brief Union of two boxes
+/// \param[in] _minA Minimum corner of the first box
+/// \param[in] _maxA Maximum corner of the first box
+/// \param[in] _minB Minimum corner of the second box
+/// \param[in] _maxB Maximum corner of the second box
+/// \param[out] _min Minimum corner of the union
+/// \param[out] _max Maximum corner of the union
+static void merge(const Corner &_minA, const Corner &_maxA,
+    const Corner &_minB, const Corner &_maxB, Corner &_min, Corner &_max)
+{
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    _min[i] = std::min(_minA[i], _minB[i]);
+    _max[i] = std::max(_maxA[i], _maxB[i]);
+  }
+}
+
+/// \brief Whether two boxes intersect
+/// \param[in] _minA Minimum corner of the first box
+/// \param[in] _maxA Maximum corner of the first box
+/// \param[in] _minB Minimum corner of the second box
+/// \param[in] _maxB Maximum corner of the second box
+/// \return True if they intersect or touch
+static bool overlaps(const Corner &_minA, const Corner &_maxA,
+    const Corner &_minB, const Corner &_maxB)
+{
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    if (_maxA[i] < _minB[i] || _minA[i] > _maxB[i])
+      return false;
+  }
+  return true;
+}
+
+/// \brief Squared distance from a point to a box
+/// \param[in] _point Point
+/// \param[in] _min Minimum corner of the box
+/// \param[in] _max Maximum corner of the box
+/// \return Squared distance, zero if the point is inside
+static double squaredDistance(const Corner &_point, const Corner &_min,
+    const Corner &_max)
+{
+  double distance{0.0};
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    const double d = std::max({_min[i] - _point[i], 0.0,
+        _point[i] - _max[i]});
+    distance += d * d;
+  }
+  return distance;
+}
+
+/// \brief Intersect a ray with a box
+/// \param[in] _origin Ray origin
+/// \param[in] _direction Normalized ray direction
+/// \param[in] _maxDistance Ray length
+/// \param[in] _min Minimum corner of the box
+/// \param[in] _max Maximum corner of the box
+/// \param[out] _distance Distance along the ray where it enters the box
+/// \return True if the ray hits the box
+static bool rayHits(const Corner &_origin, const Corner &_direction,
+    double _maxDistance, const Corner &_min, const Corner &_max,
+    double &_distance)
+{
+  double enter{0.0};
+  double leave{_maxDistance};
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    if (_direction[i] == 0.0)
+    {
+      if (_origin[i] < _min[i] || _origin[i] > _max[i])
+        return false;
+      continue;
+    }
+
+    double t1 = (_min[i] - _origin[i]) / _direction[i];
+    double t2 = (_max[i] - _origin[i]) / _direction[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    enter = std::max(enter, t1);
+    leave = std::min(leave, t2);
+    if (enter > leave)
+      return false;
+  }
+  _distance = enter;
+  return true;
+}
+
+/// \brief Convert a vector to a corner
+/// \param[in] _vec Vector
+/// \return Corner
+static Corner corner(const math::Vector3d &_vec)
+{
+  return {_vec.X(), _vec.Y(), _vec.Z()};
+}
+
+class SpatialIndex::Implementation
+{
+  /// \brief Get a node for a new leaf or inner node
+  /// \return Node index
+  public: int AllocateNode();
+
+  /// \brief Return a node to the free list
+  /// \param[in] _node Node index
+  public: void FreeNode(int _node);
+
+  /// \brief Insert a leaf next to the sibling which grows the tree's
+  /// surface area the least, then rebalance its ancestors
+  /// \param[in] _leaf Leaf index
+  public: void InsertLeaf(int _leaf);
+
+  /// \brief Detach a leaf from the tree, then rebalance its ancestors
+  /// \param[in] _leaf Leaf index
+  public: void RemoveLeaf(int _leaf);
+
+  /// \brief Refit and rebalance the ancestors of a node, starting with
+  /// the node itself
+  /// \param[in] _node Node index
+  public: void Refit(int _node);
+
+  /// \brief Rotate a child of an unbalanced node up
+  /// \param[in] _node Node index
+  /// \return Index of the node now at the same place in the tree
+  public: int Balance(int _node);
+
+  /// \brief Remove an entity, lock must be held
+  /// \param[in] _id Entity id
+  /// \return True if the entity was in the index
+  public: bool RemoveLocked(std::uint64_t _id);
+
+  /// \brief Visit the leaves whose exact bounds pass a test
+  /// \param[in] _test Callback invoked as
+  /// `bool(const Corner &_min, const Corner &_max)` for nodes and leaves
+  /// \param[in] _visit Callback invoked as `void(const TreeNode &)` for
+  /// matching leaves
+  public: template <typename TestFn, typename VisitFn>
+          void Query(TestFn &&_test, VisitFn &&_visit) const
+  {
+    if (this->root < 0)
+      return;
+
+    this->stack.clear();
+    this->stack.push_back(this->root);
+    while (!this->stack.empty())
+    {
+      const TreeNode &node = this->nodes[this->stack.back()];
+      this->stack.pop_back();
+      if (!_test(node.min, node.max))
+        continue;
+
+      if (node.Leaf())
+      {
+        if (_test(node.exactMin, node.exactMax))
+          _visit(node);
+        continue;
+      }
+      this->stack.push_back(node.left);
+      this->stack.push_back(node.right);
+    }
+  }
+
+  /// \brief Protects all members
+  public: mutable std::mutex mutex;
+
+  /// \brief Node storage, including free nodes
+  public: std::vector<TreeNode> nodes;
+
+  /// \brief Indices of free nodes
+  public: std::vector<int> freeNodes;
+
+  /// \brief Index of the root node, -1 if empty
+  public: int root{-1};
+
+  /// \brief Leaf index of each entity
+  public: std::unordered_map<std::uint64_t, int> leaves;
+
+  /// \brief Distance leaf boxes are enlarged by
+  public: double margin{0.1};
+
+  /// \brief Traversal stack, reused between queries
+  public: mutable std::vector<int> stack;
+};
+
+/////////////////////////////////////////////////
+int SpatialIndex::Implementation::AllocateNode()
+{
+  int index;
+  if (!this->freeNodes.empty())
+  {
+    index = this->freeNodes.back();
+    this->freeNodes.pop_back();
+    this->nodes[index] = TreeNode();
+  }
+  else
+  {
+    index = static_cast<int>(this->nodes.size());
+    this->nodes.emplace_back();
+  }
+  this->nodes[index].height = 0;
+  return index;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Implementation::FreeNode(int _node)
+{
+  this->nodes[_node].height = -1;
+  this->freeNodes.push_back(_node);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Implementation::InsertLeaf(int _leaf)
+{
+  if (this->root < 0)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = -1;
+    return;
+  }
+
+  // Walk down to the best sibling, comparing the cost of pairing with the
+  // current node against descending into either child
+  const Corner leafMin = this->nodes[_leaf].min;
+  const Corner leafMax = this->nodes[_leaf].max;
+  int index = this->root;
+  while (!this->nodes[index].Leaf())
+  {
+    const TreeNode &node = this->nodes[index];
+    Corner combinedMin;
+    Corner combinedMax;
+    merge(node.min, node.max, leafMin, leafMax, combinedMin, combinedMax);
+    const double combinedArea = surfaceArea(combinedMin, combinedMax);
+
+    const double cost = 2.0 * combinedArea;
+    const double inheritance =
+        2.0 * (combinedArea - surfaceArea(node.min, node.max));
+
+    auto childCost = [&](int _child)
+    {
+      const TreeNode &child = this->nodes[_child];
+      Corner min;
+      Corner max;
+      merge(child.min, child.max, leafMin, leafMax, min, max);
+      double area = surfaceArea(min, max);
+      if (!child.Leaf())
+        area -= surfaceArea(child.min, child.max);
+      return area + inheritance;
+    };
+    const double leftCost = childCost(node.left);
+    const double rightCost = childCost(node.right);
+
+    if (cost < leftCost && cost < rightCost)
+      break;
+    index = leftCost < rightCost ? node.left : node.right;
+  }
+
+  const int sibling = index;
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->AllocateNode();
+
+  TreeNode &parent = this->nodes[newParent];
+  parent.parent = oldParent;
+  parent.left = sibling;
+  parent.right = _leaf;
+  parent.height = this->nodes[sibling].height + 1;
+  merge(this->nodes[sibling].min, this->nodes[sibling].max, leafMin, leafMax,
+      parent.min, parent.max);
+
+  if (oldParent >= 0)
+  {
+    if (this->nodes[oldParent].left == sibling)
+      this->nodes[oldParent].left = newParent;
+    else
+      this->nodes[oldParent].right = newParent;
+  }
+  else
+  {
+    this->root = newParent;
+  }
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  // Start with the new node, so it's rebalanced too
+  this->Refit(newParent);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Implementation::RemoveLeaf(int _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = -1;
+    return;
+  }
+
+  const int parent = this->nodes[_leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling = this->nodes[parent].left == _leaf ?
+      this->nodes[parent].right : this->nodes[parent].left;
+
+  // The sibling takes the parent's place
+  if (grandParent >= 0)
+  {
+    if (this->nodes[grandParent].left == parent)
+      this->nodes[grandParent].left = sibling;
+    else
+      this->nodes[grandParent].right = sibling;
+  }
+  else
+  {
+    this->root = sibling;
+  }
+  this->nodes[sibling].parent = grandParent;
+  this->FreeNode(parent);
+
+  this->Refit(grandParent);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Implementation::Refit(int _node)
+{
+  int index = _node;
+  while (index >= 0)
+  {
+    index = this->Balance(index);
+
+    TreeNode &node = this->nodes[index];
+    const TreeNode &left = this->nodes[node.left];
+    const TreeNode &right = this->nodes[node.right];
+    node.height = 1 + std::max(left.height, right.height);
+    merge(left.min, left.max, right.min, right.max, node.min, node.max);
+
+    index = node.parent;
+  }
+}
+
+/////////////////////////////////////////////////
+int SpatialIndex::Implementation::Balance(int _node)
+{
+  TreeNode &a = this->nodes[_node];
+  if (a.Leaf() || a.height < 2)
+    return _node;
+
+  const int indexB = a.left;
+  const int indexC = a.right;
+  TreeNode &b = this->nodes[indexB];
+  TreeNode &c = this->nodes[indexC];
+  const int balance = c.height - b.height;
+
+  // Rotate the taller child up, and the shorter of its children down
+  // into this node
+  auto rotate = [&](int _up, TreeNode &_upNode, TreeNode &_other,
+      bool _upIsRight)
+  {
+    const int indexF = _upNode.left;
+    const int indexG = _upNode.right;
+    TreeNode &f = this->nodes[indexF];
+    TreeNode &g = this->nodes[indexG];
+
+    _upNode.left = _node;
+    _upNode.parent = a.parent;
+    a.parent = _up;
+
+    if (_upNode.parent >= 0)
+    {
+      if (this->nodes[_upNode.parent].left == _node)
+        this->nodes[_upNode.parent].left = _up;
+      else
+        this->nodes[_upNode.parent].right = _up;
+    }
+    else
+    {
+      this->root = _up;
+    }
+
+    const bool keepF = f.height > g.height;
+    const int indexKept = keepF ? indexF : indexG;
+    const int indexMoved = keepF ? indexG : indexF;
+    TreeNode &kept = keepF ? f : g;
+    TreeNode &moved = keepF ? g : f;
+
+    _upNode.right = indexKept;
+    if (_upIsRight)
+      a.right = indexMoved;
+    else
+      a.left = indexMoved;
+    moved.parent = _node;
+
+    merge(_other.min, _other.max, moved.min, moved.max, a.min, a.max);
+    merge(a.min, a.max, kept.min, kept.max, _upNode.min, _upNode.max);
+    a.height = 1 + std::max(_other.height, moved.height);
+    _upNode.height = 1 + std::max(a.height, kept.height);
+  };
+
+  if (balance > 1)
+  {
+    rotate(indexC, c, b, true);
+    return indexC;
+  }
+  if (balance < -1)
+  {
+    rotate(indexB, b, c, false);
+    return indexB;
+  }
+  return _node;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Implementation::RemoveLocked(std::uint64_t _id)
+{
+  auto it = this->leaves.find(_id);
+  if (it == this->leaves.end())
+    return false;
+
+  this->RemoveLeaf(it->second);
+  this->FreeNode(it->second);
+  this->leaves.erase(it);
+  return true;
+}
+
+/////////////////////////////////////////////////
+SpatialIndex::SpatialIndex()
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+SpatialIndex::~SpatialIndex() = default;
+
+/////////////////////////////////////////////////
+void SpatialIndex::SetMargin(double _margin)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->margin = std::max(_margin, 0.0);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Update(std::uint64_t _id, const math::AxisAlignedBox &_box)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const Corner min = corner(_box.Min());
+  const Corner max = corner(_box.Max());
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    if (!(min[i] <= max[i]) || !std::isfinite(min[i]) ||
+        !std::isfinite(max[i]))
+    {
+      this->dataPtr->RemoveLocked(_id);
+      return;
+    }
+  }
+
+  int leaf;
+  auto it = this->dataPtr->leaves.find(_id);
+  if (it != this->dataPtr->leaves.end())
+  {
+    leaf = it->second;
+    TreeNode &node = this->dataPtr->nodes[leaf];
+    node.exactMin = min;
+    node.exactMax = max;
+
+    // Still within the enlarged box, the tree doesn't change
+    bool inside{true};
+    for (std::size_t i = 0u; i < 3u; ++i)
+      inside = inside && node.min[i] <= min[i] && max[i] <= node.max[i];
+    if (inside)
+      return;
+
+    this->dataPtr->RemoveLeaf(leaf);
+  }
+  else
+  {
+    leaf = this->dataPtr->AllocateNode();
+    this->dataPtr->nodes[leaf].id = _id;
+    this->dataPtr->nodes[leaf].exactMin = min;
+    this->dataPtr->nodes[leaf].exactMax = max;
+    this->dataPtr->leaves[_id] = leaf;
+  }
+
+  TreeNode &node = this->dataPtr->nodes[leaf];
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    node.min[i] = min[i] - this->dataPtr->margin;
+    node.max[i] = max[i] + this->dataPtr->margin;
+  }
+  node.left = -1;
+  node.right = -1;
+  node.height = 0;
+  this->dataPtr->InsertLeaf(leaf);
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Remove(std::uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->RemoveLocked(_id);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->nodes.clear();
+  this->dataPtr->freeNodes.clear();
+  this->dataPtr->leaves.clear();
+  this->dataPtr->root = -1;
+}
+
+/////////////////////////////////////////////////
+std::size_t SpatialIndex::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->leaves.size();
+}
+
+/////////////////////////////////////////////////
+std::optional<math::AxisAlignedBox> SpatialIndex::Bounds(
+    std::uint64_t _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->leaves.find(_id);
+  if (it == this->dataPtr->leaves.end())
+    return std::nullopt;
+
+  const TreeNode &node = this->dataPtr->nodes[it->second];
+  return math::AxisAlignedBox(
+      math::Vector3d(node.exactMin[0], node.exactMin[1], node.exactMin[2]),
+      math::Vector3d(node.exactMax[0], node.exactMax[1], node.exactMax[2]));
+}
+
+/////////////////////////////////////////////////
+std::vector<std::uint64_t> SpatialIndex::QueryBox(
+    const math::AxisAlignedBox &_box) const
+{
+  std::vector<std::uint64_t> result;
+  const Corner min = corner(_box.Min());
+  const Corner max = corner(_box.Max());
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Query(
+      [&](const Corner &_min, const Corner &_max)
+      {
+        return overlaps(_min, _max, min, max);
+      },
+      [&result](const TreeNode &_leaf)
+      {
+        result.push_back(_leaf.id);
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::uint64_t> SpatialIndex::QueryRadius(
+    const math::Vector3d &_center, double _radius) const
+{
+  std::vector<std::uint64_t> result;
+  if (_radius < 0.0)
+    return result;
+
+  const Corner center = corner(_center);
+  const double squaredRadius = _radius * _radius;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Query(
+      [&](const Corner &_min, const Corner &_max)
+      {
+        return squaredDistance(center, _min, _max) <= squaredRadius;
+      },
+      [&result](const TreeNode &_leaf)
+      {
+        result.push_back(_leaf.id);
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::pair<std::uint64_t, double>> SpatialIndex::QueryRay(
+    const math::Vector3d &_origin, const math::Vector3d &_direction,
+    double _maxDistance) const
+{
+  std::vector<std::pair<std::uint64_t, double>> result;
+  const double length = _direction.Length();
+  if (length <= 0.0 || !(_maxDistance >= 0.0))
+    return result;
+
+  const Corner origin = corner(_origin);
+  const Corner direction = corner(_direction / length);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  double distance{0.0};
+  this->dataPtr->Query(
+      [&](const Corner &_min, const Corner &_max)
+      {
+        return rayHits(origin, direction, _maxDistance, _min, _max,
+            distance);
+      },
+      [&](const TreeNode &_leaf)
+      {
+        // The exact bounds were tested last, so distance is theirs
+        result.emplace_back(_leaf.id, distance);
+      });
+
+  std::sort(result.begin(), result.end(),
+      [](const auto &_a, const auto &_b) { return _a.second < _b.second; });
+  return result;
+}
+}  // namespace gz::gui::plugins
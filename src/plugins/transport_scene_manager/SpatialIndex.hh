@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SPATIALINDEX_HH_
+#define GZ_GUI_PLUGINS_SPATIALINDEX_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#ifndef _WIN32
+#  define SpatialIndex_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define SpatialIndex_EXPORTS_API __declspec(dllexport)
+#  else
+#    define SpatialIndex_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Bounding volume hierarchy over the world bounds of scene
+  /// entities, for finding entities by position without walking the whole
+  /// scene.
+  ///
+  /// The index is a dynamic tree of axis aligned boxes, kept balanced as
+  /// entities are added, moved and removed, so updates and queries take
+  /// logarithmic time in the number of entities. Each entity is stored with
+  /// a box enlarged by a margin, and it's only moved in the tree once its
+  /// bounds leave that box, so entities moving a little every frame are
+  /// cheap to keep up to date.
+  ///
+  /// `TransportSceneManager` keeps the index of the scene it mirrors, and
+  /// other plugins query it through `gz::gui::events::SpatialQuery`.
+  /// Entities are identified by their entity ids. All functions are thread
+  /// safe.
+  class SpatialIndex_EXPORTS_API SpatialIndex
+  {
+    /// \brief Constructor
+    public: SpatialIndex();
+
+    /// \brief Destructor
+    public: ~SpatialIndex();
+
+    /// \brief Set the distance boxes are enlarged by in the tree. Larger
+    /// margins make moving entities cheaper to update and queries a bit
+    /// slower. Only applies to entities updated afterwards.
+    /// \param[in] _margin Margin in meters.
+    public: void SetMargin(double _margin);
+
+    /// \brief Add an entity or update its bounds.
+    /// \param[in] _id Entity id.
+    /// \param[in] _box World bounds of the entity. An invalid box removes
+    /// the entity.
+    public: void Update(std::uint64_t _id, const math::AxisAlignedBox &_box);
+
+    /// \brief Remove an entity.
+    /// \param[in] _id Entity id.
+    /// \return True if the entity was in the index.
+    public: bool Remove(std::uint64_t _id);
+
+    /// \brief Remove all entities.
+    public: void Clear();
+
+    /// \brief Number of entities.
+    /// \return Number of entities.
+    public: std::size_t Size() const;
+
+    /// \brief Get the bounds of an entity.
+    /// \param[in] _id Entity id.
+    /// \return Bounds last given to Update, unset if the entity isn't in
+    /// the index.
+    public: std::optional<math::AxisAlignedBox> Bounds(
+        std::uint64_t _id) const;
+
+    /// \brief Find the entities whose bounds intersect a box.
+    /// \param[in] _box Box.
+    /// \return Entity ids, in no particular order.
+    public: std::vector<std::uint64_t> QueryBox(
+        const math::AxisAlignedBox &_box) const;
+
+    /// \brief Find the entities whose bounds are within a distance of a
+    /// point.
+    /// \param[in] _center Point.
+    /// \param[in] _radius Distance.
+    /// \return Entity ids, in no particular order.
+    public: std::vector<std::uint64_t> QueryRadius(
+        const math::Vector3d &_center, double _radius) const;
+
+    /// \brief Find the entities whose bounds are hit by a ray.
+    /// \param[in] _origin Ray origin.
+    /// \param[in] _direction Ray direction, doesn't need to be normalized.
+    /// \param[in] _maxDistance Length of the ray.
+    /// \return Entity ids with the distance along the ray to their bounds,
+    /// zero if the origin is inside, nearest first.
+    public: std::vector<std::pair<std::uint64_t, double>> QueryRay(
+        const math::Vector3d &_origin, const math::Vector3d &_direction,
+        double _maxDistance = std::numeric_limits<double>::infinity()) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_SPATIALINDEX_HH_
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "SpatialIndex.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Sort ids, to compare query results
+/// \param[in] _ids Ids
+/// \return Sorted ids
+static std::vector<std::uint64_t> sorted(std::vector<std::uint64_t> _ids)
+{
+  std::sort(_ids.begin(), _ids.end());
+  return _ids;
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, UpdateRemove)
+{
+  SpatialIndex index;
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_FALSE(index.Bounds(1u).has_value());
+  EXPECT_TRUE(index.QueryRadius(math::Vector3d::Zero, 100.0).empty());
+
+  const math::AxisAlignedBox box(0, 0, 0, 1, 1, 1);
+  index.Update(1u, box);
+  index.Update(2u, math::AxisAlignedBox(5, 5, 5, 6, 6, 6));
+  EXPECT_EQ(2u, index.Size());
+  ASSERT_TRUE(index.Bounds(1u).has_value());
+  EXPECT_EQ(box, *index.Bounds(1u));
+
+  // Small moves only update the exact bounds
+  index.Update(1u, math::AxisAlignedBox(0.05, 0, 0, 1.05, 1, 1));
+  EXPECT_EQ(math::AxisAlignedBox(0.05, 0, 0, 1.05, 1, 1), *index.Bounds(1u));
+  EXPECT_TRUE(index.QueryBox(math::AxisAlignedBox(1.02, 0, 0, 2, 1, 1))
+      .size() == 1u);
+  EXPECT_TRUE(index.QueryBox(math::AxisAlignedBox(-0.5, 0, 0, 0.01, 1, 1))
+      .empty());
+
+  // An invalid box removes the entity
+  index.Update(2u, math::AxisAlignedBox());
+  EXPECT_EQ(1u, index.Size());
+
+  EXPECT_TRUE(index.Remove(1u));
+  EXPECT_FALSE(index.Remove(1u));
+  EXPECT_EQ(0u, index.Size());
+
+  index.Update(3u, box);
+  index.Clear();
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_TRUE(index.QueryBox(box).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, Queries)
+{
+  SpatialIndex index;
+  std::unordered_map<std::uint64_t, math::AxisAlignedBox> boxes;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> size(0.1, 3.0);
+
+  auto randomBox = [&]()
+  {
+    const math::Vector3d min(position(rng), position(rng), position(rng));
+    return math::AxisAlignedBox(min,
+        min + math::Vector3d(size(rng), size(rng), size(rng)));
+  };
+
+  // Add, move and remove entities, then compare every query with a brute
+  // force search
+  for (std::uint64_t id = 0u; id < 500u; ++id)
+  {
+    boxes[id] = randomBox();
+    index.Update(id, boxes[id]);
+  }
+  for (std::uint64_t id = 0u; id < 500u; id += 3u)
+  {
+    boxes[id] = randomBox();
+    index.Update(id, boxes[id]);
+  }
+  for (std::uint64_t id = 1u; id < 500u; id += 7u)
+  {
+    EXPECT_TRUE(index.Remove(id));
+    boxes.erase(id);
+  }
+  ASSERT_EQ(boxes.size(), index.Size());
+
+  for (int i = 0; i < 50; ++i)
+  {
+    const math::AxisAlignedBox query = randomBox();
+    const math::Vector3d center(position(rng), position(rng), position(rng));
+    const double radius = size(rng) * 3.0;
+
+    std::vector<std::uint64_t> inBox;
+    std::vector<std::uint64_t> inRadius;
+    for (const auto &[id, box] : boxes)
+    {
+      bool overlap{true};
+      double squaredDistance{0.0};
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        overlap = overlap && box.Max()[axis] >= query.Min()[axis] &&
+            box.Min()[axis] <= query.Max()[axis];
+        const double d = std::max({box.Min()[axis] - center[axis], 0.0,
+            center[axis] - box.Max()[axis]});
+        squaredDistance += d * d;
+      }
+      if (overlap)
+        inBox.push_back(id);
+      if (squaredDistance <= radius * radius)
+        inRadius.push_back(id);
+    }
+
+    EXPECT_EQ(sorted(inBox), sorted(index.QueryBox(query)));
+    EXPECT_EQ(sorted(inRadius), sorted(index.QueryRadius(center, radius)));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, Ray)
+{
+  SpatialIndex index;
+  index.Update(1u, math::AxisAlignedBox(4, -1, -1, 5, 1, 1));
+  index.Update(2u, math::AxisAlignedBox(9, -1, -1, 10, 1, 1));
+  index.Update(3u, math::AxisAlignedBox(4, 5, -1, 5, 6, 1));
+  index.Update(4u, math::AxisAlignedBox(-1, -1, -1, 1, 1, 1));
+
+  // Nearest first, zero when starting inside
+  auto hits = index.QueryRay(math::Vector3d::Zero, math::Vector3d(2, 0, 0));
+  ASSERT_EQ(3u, hits.size());
+  EXPECT_EQ(4u, hits[0].first);
+  EXPECT_DOUBLE_EQ(0.0, hits[0].second);
+  EXPECT_EQ(1u, hits[1].first);
+  EXPECT_DOUBLE_EQ(4.0, hits[1].second);
+  EXPECT_EQ(2u, hits[2].first);
+  EXPECT_DOUBLE_EQ(9.0, hits[2].second);
+
+  // Limited length
+  hits = index.QueryRay(math::Vector3d(0, 0, 2), math::Vector3d(1, 0, -0.2),
+      7.0);
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(1u, hits[0].first);
+
+  EXPECT_TRUE(index.QueryRay(math::Vector3d(0, 3, 0),
+      math::Vector3d(1, 0, 0)).empty());
+  EXPECT_TRUE(index.QueryRay(math::Vector3d::Zero,
+      math::Vector3d::Zero).empty());
+}
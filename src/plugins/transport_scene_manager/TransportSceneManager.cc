@@ -16,11 +16,23 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <gz/utils/ImplPtr.hh>
-#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
-#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <QQmlProperty>
@@ -30,21 +42,30 @@
 #include <gz/msgs/link.pb.h>
 #include <gz/msgs/material.pb.h>
 #include <gz/msgs/model.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/scene.pb.h>
 #include <gz/msgs/uint32_v.pb.h>
 #include <gz/msgs/visual.pb.h>
 
 #include <gz/common/Console.hh>
-#include <gz/common/MeshManager.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/WorkerPool.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Helpers.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Capsule.hh>
+#include <gz/rendering/Light.hh>
+#include <gz/rendering/Node.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
 #include <gz/transport/Node.hh>
 #include <gz/transport/TopicUtils.hh>
 
@@ -53,15 +74,114 @@
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
 
+#include "EntityRegistry.hh"
+#include "LazyModels.hh"
+#include "LevelOfDetail.hh"
+#include "LightActivity.hh"
+#include "MaterialCache.hh"
+#include "MeshLoader.hh"
+#include "PendingPoses.hh"
+#include "PoseInterpolator.hh"
+#include "PoseBuffer.hh"
+#include "SceneSnapshot.hh"
+#include "SceneStats.hh"
+#include "SceneUpdateQueue.hh"
+#include "SpatialIndex.hh"
 #include "TransportSceneManager.hh"
 
 namespace gz::gui::plugins
 {
+/// \brief An entity waiting to be created by the incremental scene loader
+struct LoadItem
+{
+  /// \brief Message describing the entity, owned by `scene`
+  std::variant<const msgs::Model *, const msgs::Link *,
+      const msgs::Visual *, const msgs::Light *> msg;
+
+  /// \brief Visual the entity will be attached to
+  rendering::VisualPtr::weak_type parent;
+
+  /// \brief Sequence number of models and lights at the top level of the
+  /// scene msg, used to cancel them if they're deleted before being loaded.
+  /// Zero for nested entities.
+  std::uint64_t seq{0u};
+
+  /// \brief Keeps the scene msg which owns `msg` alive
+  std::shared_ptr<const msgs::Scene> scene;
+
+  /// \brief Entity id of the parent
+  unsigned int parentId{EntityRegistry<rendering::Node>::kNoParent};
+
+  /// \brief Lazily loaded model this entity is built for, if any
+  unsigned int lazyRoot{EntityRegistry<rendering::Node>::kNoParent};
+
+  /// \brief Expansion of lazyRoot this entity is built for
+  std::uint64_t lazyGeneration{0u};
+
+  /// \brief Sequence number of the load nested entities were queued from,
+  /// used to cancel them if they're deleted before being loaded
+  std::uint64_t rootSeq{0u};
+};
+
+/// \brief A visual with several levels of detail, each one built as a
+/// child visual of the entity's visual
+struct LodVisual
+{
+  /// \brief Picks the level to show
+  LevelOfDetail lod;
+
+  /// \brief Child visual of each level, most detailed first
+  std::vector<rendering::VisualPtr::weak_type> levels;
+
+  /// \brief Entity visual
+  rendering::VisualPtr::weak_type visual;
+
+  /// \brief Bounding sphere radius of the most detailed level
+  double radius{0.0};
+};
+
+/// \brief A light pose waiting to be written with the other lights
+struct LightPose
+{
+  /// \brief Light node, held until its pose is written
+  rendering::NodePtr node;
+
+  /// \brief Entity id
+  unsigned int id{0u};
+
+  /// \brief Pose to write
+  math::Pose3d pose;
+};
+
+/// \brief A top level model whose links are only built near the camera
+struct LazyModel
+{
+  /// \brief Model msg, owned by `scene`
+  const msgs::Model *msg{nullptr};
+
+  /// \brief Model visual, which stands in for the model while collapsed
+  rendering::VisualPtr::weak_type visual;
+
+  /// \brief Keeps the scene msg which owns `msg` alive
+  std::shared_ptr<const msgs::Scene> scene;
+
+  /// \brief Entity ids of everything under the model
+  std::vector<unsigned int> children;
+};
+
 /// \brief Private data class for TransportSceneManager
 class TransportSceneManager::Implementation
 {
-  /// \brief Make the scene service request and populate the scene
-  public: void Request();
+  /// \brief Check once whether the scene service is advertised, and
+  /// request the scene if it is. Gives up once serviceTimeout passed.
+  /// \return True if done, false if the service should be checked again
+  /// at nextDiscovery.
+  public: bool Request();
+
+  /// \brief Queue the next transport step on the shared worker pool,
+  /// unless one is already queued or it's not due yet. The first step
+  /// initializes transport, and each one checks for the scene service.
+  public: void QueueTransportStep();
 
   /// \brief Update the scene based on pose msgs received
   public: void OnRender();
@@ -70,13 +190,76 @@ class TransportSceneManager::Implementation
   /// To be called after a valid scene has been found.
   public: void InitializeTransport();
 
-  /// \brief Callback function for the pose topic
+  /// \brief Callback function for the pose topic. It doesn't lock
+  /// msgMutex, poses are handed to the render thread through poseBuffer.
+  /// Callbacks may run concurrently on publisher and reception threads,
+  /// so they're serialized by poseWriteMutex.
   /// \param[in] _msg Pose vector msg
   public: void OnPoseVMsg(const msgs::Pose_V &_msg);
 
-  /// \brief Load the scene from a scene msg
+  /// \brief Queue all models and lights of a scene msg to be loaded by
+  /// ProcessLoadQueue
   /// \param[in] _msg Scene msg
-  public: void LoadScene(const msgs::Scene &_msg);
+  public: void LoadScene(std::shared_ptr<const msgs::Scene> _msg);
+
+  /// \brief Start loading the meshes of a model and its nested models in
+  /// the background
+  /// \param[in] _msg Model msg
+  public: void PrefetchMeshes(const msgs::Model &_msg);
+
+  /// \brief Load queued entities until the queue is empty or the per frame
+  /// load budget is used up. The ids of the entities created are stored in
+  /// loadedIds.
+  /// \return Number of entities created
+  public: std::size_t ProcessLoadQueue();
+
+  /// \brief Create a queued entity and queue its children
+  /// \param[in] _item Entity to create
+  /// \return True if the entity was created
+  public: bool LoadQueuedItem(const LoadItem &_item);
+
+  /// \brief Find the user camera if it hasn't been found yet
+  /// \return True if there's a user camera
+  public: bool FindCamera();
+
+  /// \brief Build lazily loaded models close to the user camera and
+  /// release the ones far from it
+  public: void UpdateLazyModels();
+
+  /// \brief Show the level of detail of each visual matching its current
+  /// size on screen
+  public: void UpdateLevelsOfDetail();
+
+  /// \brief Mark the bounds of the top level entity an entity belongs to
+  /// as changed
+  /// \param[in] _id Entity id
+  public: void MarkBoundsDirty(unsigned int _id);
+
+  /// \brief Update the spatial index with the bounds which changed this
+  /// frame
+  public: void UpdateSpatialIndex();
+
+  /// \brief Write the light poses staged this frame, and update which
+  /// lights are dynamic
+  public: void UpdateLights();
+
+  /// \brief Report the statistics collected since the last report, if
+  /// the reporting period is over
+  /// \return True if a report was made
+  public: bool UpdateStats();
+
+  /// \brief Whether the meshes needed to create a queued entity are
+  /// loaded, starting to load them if not
+  /// \param[in] _item Queued entity
+  /// \return True if the entity can be created without waiting
+  public: bool MeshesReady(const LoadItem &_item);
+
+  /// \brief Queue the links and nested models of a lazily loaded model
+  /// \param[in] _id Model entity id
+  /// \param[in] _model Lazily loaded model
+  /// \param[in] _generation Expansion generation
+  public: void ExpandModel(unsigned int _id, const LazyModel &_model,
+      std::uint64_t _generation);
 
   /// \brief Callback function for the request topic
   /// \param[in] _msg Deletion message
@@ -90,20 +273,46 @@ class TransportSceneManager::Implementation
   /// \param[in] _msg Scene msg
   public: void OnSceneMsg(const msgs::Scene &_msg);
 
-  /// \brief Load the model from a model msg
+  /// \brief Apply a scene update on the render thread
+  /// \param[in] _update Scene update
+  public: void ApplySceneUpdate(SceneUpdate &&_update);
+
+  /// \brief Load the model from a model msg. Its links and nested models
+  /// are loaded separately.
   /// \param[in] _msg Model msg
+  /// \param[in] _parentId Entity id of the parent model, if nested
   /// \return Model visual created from the msg
-  public: rendering::VisualPtr LoadModel(const msgs::Model &_msg);
+  public: rendering::VisualPtr LoadModel(const msgs::Model &_msg,
+      unsigned int _parentId);
 
-  /// \brief Load a link from a link msg
+  /// \brief Load a link from a link msg. Its visuals and lights are loaded
+  /// separately.
   /// \param[in] _msg Link msg
+  /// \param[in] _parentId Entity id of the parent model
   /// \return Link visual created from the msg
-  public: rendering::VisualPtr LoadLink(const msgs::Link &_msg);
+  public: rendering::VisualPtr LoadLink(const msgs::Link &_msg,
+      unsigned int _parentId);
 
   /// \brief Load a visual from a visual msg
   /// \param[in] _msg Visual msg
+  /// \param[in] _parentId Entity id of the parent link
   /// \return Visual visual created from the msg
-  public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg);
+  public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg,
+      unsigned int _parentId);
+
+  /// \brief Create a geometry and its materials, and add it to a visual
+  /// \param[in] _msg Visual msg the geometry is created for
+  /// \param[in] _geometry Geometry msg, the visual msg's or one of its
+  /// levels of detail
+  /// \param[in] _visual Visual to add the geometry to
+  /// \param[in] _user User of shared materials, the entity id of the
+  /// visual msg
+  /// \param[out] _localPose Additional local pose to be applied after the
+  /// visual's pose
+  /// \return Geometry, null if it couldn't be created
+  public: rendering::GeometryPtr AddGeometry(const msgs::Visual &_msg,
+      const msgs::Geometry &_geometry, const rendering::VisualPtr &_visual,
+      unsigned int _user, math::Pose3d &_localPose);
 
   /// \brief Load a geometry from a geometry msg
   /// \param[in] _msg Geometry msg
@@ -121,12 +330,36 @@ class TransportSceneManager::Implementation
 
   /// \brief Load a light from a light msg
   /// \param[in] _msg Light msg
+  /// \param[in] _parentId Entity id of the parent link, if any
   /// \return Light object created from the msg
-  public: rendering::LightPtr LoadLight(const msgs::Light &_msg);
+  public: rendering::LightPtr LoadLight(const msgs::Light &_msg,
+      unsigned int _parentId);
 
-  /// \brief Delete an entity
-  /// \param[in] _entity Entity to delete
-  public: void DeleteEntity(const unsigned int _entity);
+  /// \brief Create the material for a visual msg, or get the one already
+  /// created for the same contents
+  /// \param[in] _msg Visual msg
+  /// \param[in] _user Entity id of the visual using the material
+  /// \return Shared material
+  public: rendering::MaterialPtr AcquireMaterial(const msgs::Visual &_msg,
+      unsigned int _user);
+
+  /// \brief Release the shared materials used by a visual, destroying the
+  /// ones no other visual uses
+  /// \param[in] _id Entity id of the visual
+  public: void ReleaseMaterials(unsigned int _id);
+
+  /// \brief Forget everything tracked for an entity which is being removed
+  /// from the registry. Visuals are added to removedVisuals, for their
+  /// materials to be released once they're destroyed.
+  /// \param[in] _slot Registry slot of the entity
+  public: void ForgetEntity(
+      const EntityRegistry<rendering::Node>::Slot &_slot);
+
+  /// \brief Delete entities together with everything loaded under them.
+  /// Subtrees are found through the entity registry, and each one is
+  /// destroyed with a single recursive call.
+  /// \param[in] _entities Entities to delete
+  public: void DeleteEntities(const std::vector<unsigned int> &_entities);
 
   //// \brief gz-transport scene service name
   public: std::string service{"scene"};
@@ -140,39 +373,256 @@ class TransportSceneManager::Implementation
   //// \brief gz-transport scene topic name
   public: std::string sceneTopic{"scene"};
 
+  /// \brief gz-transport topic statistics are published on. Empty to not
+  /// publish them.
+  public: std::string statsTopic;
+
   //// \brief Pointer to the rendering scene
   public: rendering::ScenePtr scene{nullptr};
 
-  //// \brief Mutex to protect the msgs
+  //// \brief Mutex to protect the scene and deletion msgs
   public: std::mutex msgMutex;
 
-  /// \brief Map of entity id to pose
-  public: std::map<unsigned int, math::Pose3d> poses;
+  /// \brief Hands the latest pose of each entity from the pose callback to
+  /// the render thread without locking.
+  public: PoseBuffer poseBuffer;
+
+  /// \brief Serializes the pose callbacks writing into poseBuffer. Never
+  /// locked by the render thread.
+  public: std::mutex poseWriteMutex;
+
+  /// \brief Dense table of the visuals and lights created from the scene,
+  /// keyed by entity id.
+  public: EntityRegistry<rendering::Node> entities;
+
+  /// \brief Materials shared by visuals with identical material msgs,
+  /// keyed by msg contents. Users are entity ids, so materials can be
+  /// released after the visual is gone.
+  public: MaterialCache<rendering::MaterialPtr> materials;
+
+  /// \brief Visuals removed from the registry whose materials haven't
+  /// been released yet
+  public: std::vector<unsigned int> removedVisuals;
 
-  /// \brief Map of entity id to initial local poses
-  /// This is currently used to handle the normal vector in plane visuals. In
-  /// general, this can be used to store any local transforms between the
-  /// parent Visual and geometry.
-  public: std::map<unsigned int, math::Pose3d> localPoses;
+  /// \brief Jitter buffer interpolating poses at render time, used if
+  /// interpolate is true
+  public: PoseInterpolator interpolator;
 
-  /// \brief Map of visual id to visual pointers.
-  public: std::map<unsigned int, rendering::VisualPtr::weak_type> visuals;
+  /// \brief Whether poses are interpolated instead of applied as received
+  public: bool interpolate{false};
 
-  /// \brief Map of light id to light pointers.
-  public: std::map<unsigned int, rendering::LightPtr::weak_type> lights;
+  /// \brief Poses received before their entity was created. They're
+  /// applied once the entity is loaded.
+  public: PendingPoses pendingPoses;
 
   /// Entities to be deleted
   public: std::vector<unsigned int> toDeleteEntities;
 
-  /// \brief Keeps the a list of unprocessed scene messages
-  public: std::vector<msgs::Scene> sceneMsgs;
+  /// \brief Unprocessed scene messages, merged as they're queued
+  public: SceneUpdateQueue sceneMsgs;
+
+  /// \brief Sequence number of the last delta scene msg queued. Unset
+  /// until the first delta arrives.
+  public: std::optional<std::uint64_t> lastSceneSeq;
+
+  /// \brief True while waiting for a full scene from the scene service,
+  /// the first one or one requested after a gap in the delta sequence
+  public: bool resyncing{true};
+
+  /// \brief True until the first response of the scene service, or the
+  /// failure to get one
+  public: bool firstScene{true};
+
+  /// \brief Deltas received while resyncing, applied on top of the full
+  /// scene, with their sequence numbers
+  public: std::vector<std::pair<std::uint64_t, msgs::Scene>> resyncDeltas;
+
+  /// \brief File the last scene received from the scene service is saved
+  /// to, and loaded from on startup. Empty to disable.
+  public: std::string sceneCache;
+
+  /// \brief Version of the scene loaded from sceneCache, until the scene
+  /// service responds
+  public: std::optional<std::string> cachedVersion;
+
+  /// \brief Entities waiting to be loaded, in load order
+  public: std::deque<LoadItem> loadQueue;
+
+  /// \brief Entities created by the last ProcessLoadQueue call
+  public: std::vector<unsigned int> loadedIds;
+
+  /// \brief Visuals taken off the load queue because their mesh is still
+  /// being loaded in the background, in load order
+  public: std::deque<LoadItem> meshWaiting;
+
+  /// \brief Loads mesh files off the render thread
+  public: MeshLoader meshLoader;
+
+  /// \brief Top level models loaded as proxies and only built near the
+  /// camera, used if lazy is true
+  public: LazyModels<LazyModel> lazyModels;
+
+  /// \brief Whether top level models are built lazily
+  public: bool lazy{false};
+
+  /// \brief Lazily loaded model each entity under one belongs to
+  public: std::unordered_map<unsigned int, unsigned int> lazyChildren;
+
+  /// \brief Last pose of entities under lazily loaded models which aren't
+  /// built, applied once they're built. They're not kept in pendingPoses,
+  /// which is for entities that are about to be loaded.
+  public: std::unordered_map<unsigned int, math::Pose3d> lazyPoses;
+
+  /// \brief User camera, used to find out which lazy models to build and
+  /// which levels of detail to show
+  public: rendering::CameraPtr camera{nullptr};
+
+  /// \brief Visuals with several levels of detail, keyed by entity id
+  public: std::unordered_map<unsigned int, LodVisual> lodVisuals;
+
+  /// \brief Screen size below which mesh visuals are replaced by a box of
+  /// their bounds. Zero to never replace them.
+  public: double lodProxyScreenSize{0.0};
+
+  /// \brief Top level entities deleted while queued for loading, mapped to
+  /// the last load sequence number issued when they were deleted
+  public: std::unordered_map<unsigned int, std::uint64_t> cancelledLoads;
+
+  /// \brief Hash of the msg each top level model and light was loaded
+  /// from, used to keep the ones which didn't change when a full scene is
+  /// received
+  public: std::unordered_map<unsigned int, std::uint64_t> topLevelHashes;
+
+  /// \brief Last sequence number given to a top level load item
+  public: std::uint64_t loadSeq{0u};
+
+  /// \brief Maximum time spent loading entities per frame. Zero to load
+  /// everything in one frame.
+  public: std::chrono::steady_clock::duration loadBudget{
+      std::chrono::milliseconds(10)};
+
+  /// \brief Maximum number of entities loaded per frame. Zero for no limit.
+  public: unsigned int maxLoadsPerFrame{0u};
+
+  /// \brief Number of entities queued since the queue was last empty
+  public: std::size_t loadTotal{0u};
+
+  /// \brief Number of queued entities processed since the queue was last
+  /// empty
+  public: std::size_t loadDone{0u};
+
+  /// \brief Last load progress reported to the UI. Written on the render
+  /// thread and read on the GUI thread.
+  public: std::atomic<double> loadProgress{1.0};
+
+  /// \brief Spatial index of the top level visuals, null if disabled.
+  /// Created with the config, before any query can arrive.
+  public: std::unique_ptr<SpatialIndex> spatialIndex;
+
+  /// \brief Whether to keep a spatial index
+  public: bool useSpatialIndex{false};
+
+  /// \brief Margin of the spatial index's boxes, in meters
+  public: double spatialIndexMargin{0.1};
+
+  /// \brief Top level entities whose bounds changed this frame
+  public: std::unordered_set<unsigned int> dirtyBounds;
+
+  /// \brief Tracks which lights are moving
+  public: LightActivity lightActivity;
+
+  /// \brief Light poses staged this frame
+  public: std::vector<LightPose> lightPoses;
+
+  /// \brief Whether dynamic lights keep casting shadows while they move
+  public: bool dynamicLightShadows{true};
+
+  /// \brief Number of frames rendered
+  public: std::uint64_t frameCount{0u};
+
+  /// \brief Statistics of the current reporting period. Only used on the
+  /// render thread.
+  public: SceneStats stats;
+
+  /// \brief Length of a statistics reporting period
+  public: std::chrono::steady_clock::duration statsPeriod{
+      std::chrono::seconds(1)};
+
+  /// \brief Start of the current statistics reporting period
+  public: std::chrono::steady_clock::time_point statsStart;
+
+  /// \brief Totals of the cumulative counters at the start of the period:
+  /// applied, skipped and dropped poses, and merged scene msgs
+  public: std::array<std::uint64_t, 4> statsTotals{};
+
+  /// \brief Number of merged scene msgs, read while msgMutex is locked
+  public: std::uint64_t mergedSceneMsgs{0u};
+
+  /// \brief Pose msgs received since the last report
+  public: std::atomic<std::uint64_t> poseMsgCount{0u};
+
+  /// \brief Scene msgs received since the last report
+  public: std::atomic<std::uint64_t> sceneMsgCount{0u};
+
+  /// \brief Time the entities queued since the queue was last empty
+  /// started loading
+  public: std::optional<std::chrono::steady_clock::time_point> sceneLoadStart;
+
+  /// \brief Publisher for statistics
+  public: transport::Node::Publisher statsPub;
+
+  /// \brief Summary of the last report shown in the UI. Protected by
+  /// statsMutex.
+  public: QString statsSummary;
+
+  /// \brief Protects statsSummary
+  public: mutable std::mutex statsMutex;
 
   /// \brief Transport node for making service request and subscribing to
   /// pose topic
   public: gz::transport::Node node;
 
-  /// \brief Thread to wait for transport initialization
-  public: std::thread initializeTransport;
+  /// \brief Name of the scene to populate. Empty for the first scene of
+  /// the first loaded render engine.
+  public: std::string sceneName;
+
+  /// \brief True while a transport step is queued or running on the
+  /// shared worker pool. Protected by stopMutex.
+  public: bool transportBusy{false};
+
+  /// \brief True once the scene was requested, or discovery gave up.
+  /// Protected by stopMutex.
+  public: bool transportDone{false};
+
+  /// \brief True once InitializeTransport ran. Only used by transport
+  /// steps, which never run concurrently.
+  public: bool transportInitialized{false};
+
+  /// \brief When to check for the scene service next. Protected by
+  /// stopMutex.
+  public: std::chrono::steady_clock::time_point nextDiscovery;
+
+  /// \brief Wait before the next check for the scene service. Only used by
+  /// transport steps.
+  public: std::chrono::steady_clock::duration discoveryDelay{
+      std::chrono::milliseconds(5)};
+
+  /// \brief When to stop waiting for the scene service. Only used by
+  /// transport steps.
+  public: std::chrono::steady_clock::time_point discoveryDeadline;
+
+  /// \brief Maximum time to wait for the scene service to be advertised
+  public: std::chrono::steady_clock::duration serviceTimeout{
+      std::chrono::seconds(30)};
+
+  /// \brief Protects stopping and the transport step state
+  public: std::mutex stopMutex;
+
+  /// \brief Notified when a transport step finishes
+  public: std::condition_variable stopCv;
+
+  /// \brief True when the plugin is being destroyed
+  public: bool stopping{false};
 };
 
 /////////////////////////////////////////////////
@@ -184,8 +634,27 @@ TransportSceneManager::TransportSceneManager()
 /////////////////////////////////////////////////
 TransportSceneManager::~TransportSceneManager()
 {
-  if (this->dataPtr->initializeTransport.joinable())
-    this->dataPtr->initializeTransport.join();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->stopMutex);
+    this->dataPtr->stopping = true;
+  }
+
+  // The worker pool outlives this instance, so wait for the transport
+  // step instead of the pool. A step which didn't start yet returns
+  // right away.
+  std::unique_lock<std::mutex> lock(this->dataPtr->stopMutex);
+  this->dataPtr->stopCv.wait(lock,
+      [this] { return !this->dataPtr->transportBusy; });
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the text of an element, for error messages
+/// \param[in] _elem Element
+/// \return Text, empty if the element has none
+static const char *elementText(const tinyxml2::XMLElement *_elem)
+{
+  const char *text = _elem->GetText();
+  return nullptr != text ? text : "";
 }
 
 /////////////////////////////////////////////////
@@ -224,6 +693,294 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       this->dataPtr->sceneTopic =
           transport::TopicUtils::AsValidTopic(elem->GetText());
     }
+
+    elem = _pluginElem->FirstChildElement("scene");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->sceneName = elem->GetText();
+    }
+
+    elem = _pluginElem->FirstChildElement("stats_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->statsTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("stats_period");
+    if (nullptr != elem)
+    {
+      double period{0.0};
+      if (elem->QueryDoubleText(&period) == tinyxml2::XML_SUCCESS &&
+          period > 0.0)
+      {
+        this->dataPtr->statsPeriod =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(period));
+      }
+      else
+      {
+        gzerr << "Failed to parse <stats_period> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_cache");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->sceneCache = common::absPath(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("max_pending_poses");
+    if (nullptr != elem)
+    {
+      unsigned int maxPendingPoses{0u};
+      if (elem->QueryUnsignedText(&maxPendingPoses) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->pendingPoses.SetCapacity(maxPendingPoses);
+      }
+      else
+      {
+        gzerr << "Failed to parse <max_pending_poses> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("pending_pose_timeout");
+    if (nullptr != elem)
+    {
+      double timeout{0.0};
+      if (elem->QueryDoubleText(&timeout) == tinyxml2::XML_SUCCESS &&
+          timeout >= 0.0)
+      {
+        this->dataPtr->pendingPoses.SetMaxAge(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(timeout)));
+      }
+      else
+      {
+        gzerr << "Failed to parse <pending_pose_timeout> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("load_budget_ms");
+    if (nullptr != elem)
+    {
+      double budget{0.0};
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS &&
+          budget >= 0.0)
+      {
+        this->dataPtr->loadBudget =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget));
+      }
+      else
+      {
+        gzerr << "Failed to parse <load_budget_ms> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("playout_delay_ms");
+    if (nullptr != elem)
+    {
+      double delay{0.0};
+      if (elem->QueryDoubleText(&delay) == tinyxml2::XML_SUCCESS &&
+          delay >= 0.0)
+      {
+        this->dataPtr->interpolate = delay > 0.0;
+        this->dataPtr->interpolator.SetDelay(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(delay)));
+      }
+      else
+      {
+        gzerr << "Failed to parse <playout_delay_ms> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("pose_buffer_size");
+    if (nullptr != elem)
+    {
+      unsigned int size{0u};
+      if (elem->QueryUnsignedText(&size) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->interpolator.SetCapacity(size);
+      }
+      else
+      {
+        gzerr << "Failed to parse <pose_buffer_size> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    double poseEpsilon{0.0};
+    elem = _pluginElem->FirstChildElement("pose_epsilon");
+    if (nullptr != elem)
+    {
+      if (elem->QueryDoubleText(&poseEpsilon) != tinyxml2::XML_SUCCESS ||
+          poseEpsilon < 0.0)
+      {
+        gzerr << "Failed to parse <pose_epsilon> value: "
+              << elementText(elem) << std::endl;
+        poseEpsilon = 0.0;
+      }
+    }
+
+    double poseAngularEpsilon{0.0};
+    elem = _pluginElem->FirstChildElement("pose_angular_epsilon");
+    if (nullptr != elem)
+    {
+      if (elem->QueryDoubleText(&poseAngularEpsilon) !=
+          tinyxml2::XML_SUCCESS || poseAngularEpsilon < 0.0)
+      {
+        gzerr << "Failed to parse <pose_angular_epsilon> value: "
+              << elementText(elem) << std::endl;
+        poseAngularEpsilon = 0.0;
+      }
+    }
+    this->dataPtr->entities.SetPoseTolerance(poseEpsilon, poseAngularEpsilon);
+
+    double lazyLoadDistance{0.0};
+    elem = _pluginElem->FirstChildElement("lazy_load_distance");
+    if (nullptr != elem)
+    {
+      if (elem->QueryDoubleText(&lazyLoadDistance) != tinyxml2::XML_SUCCESS ||
+          lazyLoadDistance < 0.0)
+      {
+        gzerr << "Failed to parse <lazy_load_distance> value: "
+              << elementText(elem) << std::endl;
+        lazyLoadDistance = 0.0;
+      }
+    }
+
+    const double defaultUnloadDistance{lazyLoadDistance * 1.25};
+    double lazyUnloadDistance{defaultUnloadDistance};
+    elem = _pluginElem->FirstChildElement("lazy_unload_distance");
+    if (nullptr != elem)
+    {
+      if (elem->QueryDoubleText(&lazyUnloadDistance) != tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Failed to parse <lazy_unload_distance> value: "
+              << elementText(elem) << std::endl;
+        lazyUnloadDistance = defaultUnloadDistance;
+      }
+      else if (lazyUnloadDistance < lazyLoadDistance)
+      {
+        gzerr << "<lazy_unload_distance> [" << lazyUnloadDistance
+              << "] is below <lazy_load_distance> [" << lazyLoadDistance
+              << "], using [" << defaultUnloadDistance << "]" << std::endl;
+        lazyUnloadDistance = defaultUnloadDistance;
+      }
+    }
+    this->dataPtr->lazy = lazyLoadDistance > 0.0;
+    this->dataPtr->lazyModels.SetDistances(lazyLoadDistance,
+        lazyUnloadDistance);
+
+    elem = _pluginElem->FirstChildElement("lod_proxy_screen_size");
+    if (nullptr != elem)
+    {
+      double size{0.0};
+      if (elem->QueryDoubleText(&size) == tinyxml2::XML_SUCCESS &&
+          size >= 0.0)
+      {
+        this->dataPtr->lodProxyScreenSize = size;
+      }
+      else
+      {
+        gzerr << "Failed to parse <lod_proxy_screen_size> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("dynamic_light_shadows");
+    if (nullptr != elem &&
+        elem->QueryBoolText(&this->dataPtr->dynamicLightShadows) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <dynamic_light_shadows> value: "
+            << elementText(elem) << std::endl;
+    }
+
+    std::uint64_t lightSettleFrames =
+        this->dataPtr->lightActivity.SettleFrames();
+    elem = _pluginElem->FirstChildElement("light_settle_frames");
+    if (nullptr != elem)
+    {
+      unsigned int frames{0u};
+      if (elem->QueryUnsignedText(&frames) == tinyxml2::XML_SUCCESS)
+      {
+        lightSettleFrames = frames;
+      }
+      else
+      {
+        gzerr << "Failed to parse <light_settle_frames> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    std::uint32_t lightDynamicMoves =
+        this->dataPtr->lightActivity.MovesToDynamic();
+    elem = _pluginElem->FirstChildElement("light_dynamic_moves");
+    if (nullptr != elem)
+    {
+      unsigned int moves{0u};
+      if (elem->QueryUnsignedText(&moves) == tinyxml2::XML_SUCCESS &&
+          moves > 0u)
+      {
+        lightDynamicMoves = moves;
+      }
+      else
+      {
+        gzerr << "Failed to parse <light_dynamic_moves> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+    this->dataPtr->lightActivity.SetThresholds(lightSettleFrames,
+        lightDynamicMoves);
+
+    elem = _pluginElem->FirstChildElement("spatial_index");
+    if (nullptr != elem &&
+        elem->QueryBoolText(&this->dataPtr->useSpatialIndex) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <spatial_index> value: "
+            << elementText(elem) << std::endl;
+    }
+
+    elem = _pluginElem->FirstChildElement("spatial_index_margin");
+    if (nullptr != elem)
+    {
+      double margin{0.0};
+      if (elem->QueryDoubleText(&margin) == tinyxml2::XML_SUCCESS &&
+          margin >= 0.0)
+      {
+        this->dataPtr->spatialIndexMargin = margin;
+      }
+      else
+      {
+        gzerr << "Failed to parse <spatial_index_margin> value: "
+              << elementText(elem) << std::endl;
+      }
+    }
+
+    if (this->dataPtr->useSpatialIndex)
+    {
+      this->dataPtr->spatialIndex = std::make_unique<SpatialIndex>();
+      this->dataPtr->spatialIndex->SetMargin(
+          this->dataPtr->spatialIndexMargin);
+    }
+
+    elem = _pluginElem->FirstChildElement("max_loads_per_frame");
+    if (nullptr != elem &&
+        elem->QueryUnsignedText(&this->dataPtr->maxLoadsPerFrame) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <max_loads_per_frame> value: "
+            << elementText(elem) << std::endl;
+    }
   }
 
   QQmlProperty::write(this->PluginItem(), "service",
@@ -248,6 +1005,23 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   }
   else
   {
+    // Advertise before the render thread starts reporting
+    if (!this->dataPtr->statsTopic.empty())
+    {
+      this->dataPtr->statsPub = this->dataPtr->node.Advertise<msgs::Param>(
+          this->dataPtr->statsTopic);
+      if (!this->dataPtr->statsPub)
+      {
+        gzerr << "Error advertising stats topic: "
+              << this->dataPtr->statsTopic << std::endl;
+      }
+      else
+      {
+        gzmsg << "Publishing scene stats on ["
+              << this->dataPtr->statsTopic << "]" << std::endl;
+      }
+    }
+
     if (auto app = gz::gui::App()) {
       if (auto mainWindow = app->findChild<gz::gui::MainWindow *>()) {
         mainWindow->installEventFilter(this);
@@ -259,8 +1033,22 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void TransportSceneManager::Implementation::InitializeTransport()
 {
-  this->Request();
+  // Show the scene from the last run while waiting for the scene service
+  if (!this->sceneCache.empty())
+  {
+    msgs::Scene cached;
+    if (SceneSnapshot::Read(this->sceneCache, cached))
+    {
+      gzmsg << "Loaded cached scene from [" << this->sceneCache << "]"
+            << std::endl;
+      std::lock_guard<std::mutex> lock(this->msgMutex);
+      this->cachedVersion = SceneSnapshot::Version(cached);
+      this->sceneMsgs.Push({std::move(cached), SceneUpdate::Kind::kAdd});
+    }
+  }
 
+  // Subscribe first, so nothing published while waiting for the scene
+  // service is missed
   if (!this->node.Subscribe(this->poseTopic,
       &Implementation::OnPoseVMsg, this))
   {
@@ -285,216 +1073,1289 @@ void TransportSceneManager::Implementation::InitializeTransport()
            << "]" << std::endl;
   }
 
-  if (!this->node.Subscribe(this->sceneTopic,
-      &Implementation::OnSceneMsg, this))
+  if (!this->node.Subscribe(this->sceneTopic,
+      &Implementation::OnSceneMsg, this))
+  {
+    gzerr << "Error subscribing to scene topic: " << this->sceneTopic
+           << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to scene messages on [" << this->sceneTopic << "]"
+           << std::endl;
+  }
+
+  this->discoveryDeadline = std::chrono::steady_clock::now() +
+      this->serviceTimeout;
+
+  gzmsg << "Transport initialized." << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
+{
+  if (_event->type() == events::Render::kType)
+  {
+    this->dataPtr->OnRender();
+
+    double progress{1.0};
+    if (this->dataPtr->loadTotal > 0u)
+    {
+      progress = static_cast<double>(this->dataPtr->loadDone) /
+          static_cast<double>(this->dataPtr->loadTotal);
+    }
+    this->SetLoadProgress(progress);
+
+    if (this->dataPtr->UpdateStats())
+      emit this->StatsChanged();
+  }
+  else if (_event->type() == events::SpatialQuery::kType &&
+      this->dataPtr->spatialIndex)
+  {
+    auto query = static_cast<events::SpatialQuery *>(_event);
+    const auto &index = *this->dataPtr->spatialIndex;
+    switch (query->QueryShape())
+    {
+      case events::SpatialQuery::Shape::kBox:
+        for (const auto id : index.QueryBox(query->Box()))
+          query->AddResult(id);
+        break;
+      case events::SpatialQuery::Shape::kRadius:
+        for (const auto id : index.QueryRadius(query->Point(),
+            query->Distance()))
+        {
+          query->AddResult(id);
+        }
+        break;
+      case events::SpatialQuery::Shape::kRay:
+        for (const auto &[id, distance] : index.QueryRay(query->Point(),
+            query->Direction(), query->Distance()))
+        {
+          query->AddResult(id, distance);
+        }
+        break;
+    }
+  }
+
+  // Standard event processing
+  return QObject::eventFilter(_obj, _event);
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManager::Implementation::Request()
+{
+  // wait for the service to be advertized. Discovery usually takes a few
+  // milliseconds, so check often at first and back off exponentially.
+  const std::chrono::steady_clock::duration maxDelay =
+      std::chrono::seconds(1);
+  std::vector<transport::ServicePublisher> publishers;
+  this->node.ServiceInfo(this->service, publishers);
+  const auto now = std::chrono::steady_clock::now();
+  if (publishers.empty() && now < this->discoveryDeadline)
+  {
+    if (this->discoveryDelay >= maxDelay)
+      gzdbg << "Waiting for service [" << this->service << "]\n";
+
+    {
+      std::lock_guard<std::mutex> lock(this->stopMutex);
+      this->nextDiscovery = now + this->discoveryDelay;
+    }
+    this->discoveryDelay = std::min(this->discoveryDelay * 2, maxDelay);
+    return false;
+  }
+
+  // Deltas received so far are held back until there's a scene to apply
+  // them to, so let them through if there won't be one
+  if (publishers.empty() || !this->node.Request(this->service,
+      &Implementation::OnSceneSrvMsg, this))
+  {
+    this->OnSceneSrvMsg(msgs::Scene(), false);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::MarkBoundsDirty(unsigned int _id)
+{
+  const auto *slot = this->entities.Find(_id);
+  while (nullptr != slot &&
+         slot->parent != EntityRegistry<rendering::Node>::kNoParent)
+  {
+    slot = this->entities.Find(slot->parent);
+  }
+  if (nullptr != slot)
+    this->dirtyBounds.insert(slot->id);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateSpatialIndex()
+{
+  for (const unsigned int id : this->dirtyBounds)
+  {
+    const auto *slot = this->entities.Find(id);
+    if (nullptr == slot)
+      continue;
+
+    // Lights have no bounds
+    auto visual = std::dynamic_pointer_cast<rendering::Visual>(
+        slot->node.lock());
+    if (visual)
+      this->spatialIndex->Update(id, visual->BoundingBox());
+  }
+  this->dirtyBounds.clear();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateLights()
+{
+  // Lights whose pose didn't change were skipped by the registry, so only
+  // moving lights get here
+  for (const auto &lightPose : this->lightPoses)
+  {
+    lightPose.node->SetLocalPose(lightPose.pose);
+    if (this->lightActivity.Moved(lightPose.id, this->frameCount) &&
+        !this->dynamicLightShadows)
+    {
+      if (auto light =
+          std::dynamic_pointer_cast<rendering::Light>(lightPose.node))
+        light->SetCastShadows(false);
+    }
+  }
+  this->lightPoses.clear();
+
+  this->lightActivity.Settle(this->frameCount,
+      [this](unsigned int _id, bool _castShadows)
+      {
+        if (this->dynamicLightShadows || !_castShadows)
+          return;
+
+        const auto *slot = this->entities.Find(_id);
+        if (nullptr == slot)
+          return;
+        if (auto light = std::dynamic_pointer_cast<rendering::Light>(
+            slot->node.lock()))
+        {
+          light->SetCastShadows(true);
+        }
+      });
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManager::Implementation::UpdateStats()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (this->statsStart == std::chrono::steady_clock::time_point())
+    this->statsStart = now;
+  if (now - this->statsStart < this->statsPeriod)
+    return false;
+
+  // Turn cumulative totals into counts over the period
+  const std::array<std::uint64_t, 4> totals{
+      this->entities.AppliedPoseCount(), this->entities.SkippedPoseCount(),
+      this->pendingPoses.DroppedCount(), this->mergedSceneMsgs};
+  const std::array<SceneStats::Counter, 4> counters{
+      SceneStats::Counter::kPosesApplied, SceneStats::Counter::kPosesSkipped,
+      SceneStats::Counter::kPosesDropped,
+      SceneStats::Counter::kSceneMsgsMerged};
+  for (std::size_t i = 0u; i < totals.size(); ++i)
+    this->stats.Add(counters[i], totals[i] - this->statsTotals[i]);
+  this->statsTotals = totals;
+  this->stats.Add(SceneStats::Counter::kPoseMsgs,
+      this->poseMsgCount.exchange(0u));
+  this->stats.Add(SceneStats::Counter::kSceneMsgs,
+      this->sceneMsgCount.exchange(0u));
+
+  const double period =
+      std::chrono::duration<double>(now - this->statsStart).count();
+  if (this->statsPub)
+  {
+    msgs::Param msg;
+    this->stats.Fill(period, msg);
+    this->statsPub.Publish(msg);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->statsMutex);
+    this->statsSummary = QString::fromStdString(this->stats.Summary(period));
+  }
+
+  this->stats.Reset();
+  this->statsStart = now;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnPoseVMsg(const msgs::Pose_V &_msg)
+{
+  std::chrono::steady_clock::duration stamp{0};
+  if (_msg.has_header() && _msg.header().has_stamp())
+  {
+    stamp = math::secNsecToDuration(_msg.header().stamp().sec(),
+        _msg.header().stamp().nsec());
+  }
+
+  ++this->poseMsgCount;
+
+  // In-process publishers call back on their own thread, so there may be
+  // several producers
+  std::lock_guard<std::mutex> lock(this->poseWriteMutex);
+  PoseFrame &frame = this->poseBuffer.WriteFrame();
+  frame.MarkReceived(std::chrono::steady_clock::now());
+  for (int i = 0; i < _msg.pose_size(); ++i)
+  {
+    frame.Set(_msg.pose(i).id(), msgs::Convert(_msg.pose(i)), stamp);
+  }
+  this->poseBuffer.Publish();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnDeletionMsg(
+  const msgs::UInt32_V &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->msgMutex);
+  std::copy(_msg.data().begin(), _msg.data().end(),
+            std::back_inserter(this->toDeleteEntities));
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the worker pool shared by all instances in the process.
+/// Instances only queue short steps on it and wait for the scene service
+/// between steps, so a couple of threads serve any number of instances.
+/// \return Worker pool
+static common::WorkerPool &sharedWorkerPool()
+{
+  static common::WorkerPool pool(2u);
+  return pool;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::QueueTransportStep()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->stopMutex);
+    if (this->transportDone || this->transportBusy ||
+        std::chrono::steady_clock::now() < this->nextDiscovery)
+    {
+      return;
+    }
+    this->transportBusy = true;
+  }
+
+  sharedWorkerPool().AddWork([this]
+  {
+    bool stop{false};
+    {
+      std::lock_guard<std::mutex> lock(this->stopMutex);
+      stop = this->stopping;
+    }
+
+    bool done{true};
+    if (!stop)
+    {
+      if (!this->transportInitialized)
+      {
+        this->InitializeTransport();
+        this->transportInitialized = true;
+      }
+      done = this->Request();
+    }
+
+    std::lock_guard<std::mutex> lock(this->stopMutex);
+    this->transportDone = done;
+    this->transportBusy = false;
+    this->stopCv.notify_all();
+  });
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a scene by name in any of the loaded render engines
+/// \param[in] _name Scene name
+/// \return Scene, null if not found
+static rendering::ScenePtr sceneByName(const std::string &_name)
+{
+  for (const auto &engineName : rendering::loadedEngines())
+  {
+    auto engine = rendering::engine(engineName);
+    if (nullptr == engine)
+      continue;
+
+    auto scene = engine->SceneByName(_name);
+    if (nullptr != scene)
+      return scene;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnRender()
+{
+  if (nullptr == this->scene)
+  {
+    this->scene = this->sceneName.empty() ?
+        rendering::sceneFromFirstRenderEngine() :
+        sceneByName(this->sceneName);
+    if (nullptr == this->scene)
+      return;
+  }
+
+  this->QueueTransportStep();
+
+  // Take the queued messages and release the lock before touching the
+  // scene, so the transport callbacks aren't blocked by rendering calls
+  std::vector<SceneUpdate> sceneMsgsToLoad;
+  std::vector<unsigned int> entitiesToDelete;
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    sceneMsgsToLoad = this->sceneMsgs.Take();
+    entitiesToDelete.swap(this->toDeleteEntities);
+    this->mergedSceneMsgs = this->sceneMsgs.MergedCount();
+  }
+
+  for (auto &update : sceneMsgsToLoad)
+  {
+    this->ApplySceneUpdate(std::move(update));
+  }
+
+  if (!entitiesToDelete.empty())
+    this->DeleteEntities(entitiesToDelete);
+
+  if (this->lazy)
+    this->UpdateLazyModels();
+
+  const std::size_t loaded = this->ProcessLoadQueue();
+
+  // Apply poses that arrived before their entities were loaded. Newer poses
+  // from the current frame are staged afterwards and take precedence.
+  if (loaded > 0u &&
+      (this->pendingPoses.Size() > 0u || !this->lazyPoses.empty()))
+  {
+    math::Pose3d pose;
+    for (const auto id : this->loadedIds)
+    {
+      auto lazyPose = this->lazyPoses.find(id);
+      if (lazyPose != this->lazyPoses.end())
+      {
+        this->entities.StagePose(id, lazyPose->second);
+        this->lazyPoses.erase(lazyPose);
+      }
+      else if (this->pendingPoses.Take(id, pose))
+      {
+        this->entities.StagePose(id, pose);
+      }
+    }
+  }
+
+  if (const PoseFrame *frame = this->poseBuffer.Acquire())
+  {
+    if (!frame->Empty())
+    {
+      this->stats.Add(SceneStats::Metric::kPoseAge,
+          std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - frame->Received()).count());
+    }
+    // The frame may merge several msgs, so stamps aren't in order. Time
+    // only moves once per frame, by the newest stamp.
+    std::chrono::steady_clock::duration latest{0};
+    for (const auto &entityPose : frame->Poses())
+      latest = std::max(latest, entityPose.stamp);
+    this->pendingPoses.Advance(latest);
+
+    for (const auto &entityPose : frame->Poses())
+    {
+      // Poses without a time stamp can't be interpolated
+      if (this->interpolate && entityPose.stamp.count() != 0 &&
+          this->entities.Contains(entityPose.id))
+      {
+        this->interpolator.Add(entityPose.id, entityPose.pose,
+            entityPose.stamp);
+      }
+      else if (!this->entities.StagePose(entityPose.id, entityPose.pose))
+      {
+        // Entities under lazy models which aren't built may not be loaded
+        // for a long time
+        if (this->lazyChildren.count(entityPose.id) > 0u)
+        {
+          this->lazyPoses[entityPose.id] = entityPose.pose;
+        }
+        else
+        {
+          this->pendingPoses.Add(entityPose.id, entityPose.pose,
+              entityPose.stamp);
+        }
+      }
+    }
+  }
+
+  if (this->interpolate)
+  {
+    this->interpolator.Update(std::chrono::steady_clock::now(),
+        [this](unsigned int _id, const math::Pose3d &_pose)
+        {
+          this->entities.StagePose(_id, _pose);
+        });
+  }
+
+  ++this->frameCount;
+  this->entities.ApplyStagedPoses(
+      [this](rendering::Node &_node, const auto &_slot)
+      {
+        if (this->spatialIndex)
+          this->MarkBoundsDirty(_slot.id);
+
+        // Lights are written together once the visuals are done
+        if (_slot.type == EntityType::kLight)
+          this->lightPoses.push_back({_slot.node.lock(), _slot.id,
+              _slot.pose});
+        else
+          _node.SetLocalPose(_slot.pose);
+        return true;
+      },
+      [this](const auto &_slot)
+      {
+        // The node was destroyed behind our back, clean up as if it had
+        // been deleted
+        this->ForgetEntity(_slot);
+      });
+
+  // Nodes which expired are already gone
+  for (const auto id : this->removedVisuals)
+    this->ReleaseMaterials(id);
+  this->removedVisuals.clear();
+
+  if (!this->lightPoses.empty() || this->lightActivity.DynamicCount() > 0u)
+    this->UpdateLights();
+
+  if (!this->dirtyBounds.empty())
+    this->UpdateSpatialIndex();
+
+  if (!this->lodVisuals.empty())
+    this->UpdateLevelsOfDetail();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the values of a header data entry of a msg
+/// \param[in] _msg Msg with a header, e.g. a scene or visual msg
+/// \param[in] _key Data key
+/// \return Values, null if the key isn't present
+template <typename MsgT>
+static const google::protobuf::RepeatedPtrField<std::string> *headerData(
+    const MsgT &_msg, const std::string &_key)
+{
+  if (!_msg.has_header())
+    return nullptr;
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == _key)
+      return &data.value();
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Hash the contents of a msg
+/// \param[in] _msg Msg
+/// \return Hash
+static std::uint64_t contentHash(const google::protobuf::Message &_msg)
+{
+  const std::string payload = _msg.SerializeAsString();
+  return SceneSnapshot::Hash(payload.data(), payload.size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Keep the elements of a repeated msg field matching a predicate,
+/// in order
+/// \param[in, out] _field Field
+/// \param[in] _keep Predicate
+template <typename MsgT, typename Fn>
+static void keepIf(google::protobuf::RepeatedPtrField<MsgT> &_field,
+    Fn &&_keep)
+{
+  int kept{0};
+  for (int i = 0; i < _field.size(); ++i)
+  {
+    if (_keep(_field.Get(i)))
+      _field.SwapElements(kept++, i);
+  }
+  _field.DeleteSubrange(kept, _field.size() - kept);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the delta sequence number of a scene msg
+/// \param[in] _msg Scene msg
+/// \return Sequence number, unset if the msg isn't a delta
+static std::optional<std::uint64_t> sceneSeq(const msgs::Scene &_msg)
+{
+  auto values = headerData(_msg, "seq");
+  if (nullptr == values || values->empty())
+    return std::nullopt;
+
+  try
+  {
+    return std::stoull(values->Get(0));
+  }
+  catch (...)
+  {
+    gzerr << "Invalid scene msg seq [" << values->Get(0) << "]"
+          << std::endl;
+    return std::nullopt;
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnSceneMsg(const msgs::Scene &_msg)
+{
+  ++this->sceneMsgCount;
+  const auto seq = sceneSeq(_msg);
+  bool requestResync{false};
+
+  // Copy before locking, the copy is then moved through the queue
+  msgs::Scene msg(_msg);
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    if (!seq)
+    {
+      this->sceneMsgs.Push({std::move(msg), SceneUpdate::Kind::kAdd});
+      return;
+    }
+
+    if (this->resyncing)
+    {
+      this->resyncDeltas.emplace_back(*seq, std::move(msg));
+      return;
+    }
+
+    // Duplicate or out of date
+    if (this->lastSceneSeq && *seq <= *this->lastSceneSeq)
+      return;
+
+    if (this->lastSceneSeq && *seq != *this->lastSceneSeq + 1u)
+    {
+      gzwarn << "Missed scene updates " << *this->lastSceneSeq + 1u
+             << " to " << *seq - 1u << ", requesting the full scene"
+             << std::endl;
+      this->resyncing = true;
+      this->resyncDeltas.emplace_back(*seq, std::move(msg));
+      requestResync = true;
+    }
+    else
+    {
+      this->lastSceneSeq = seq;
+      this->sceneMsgs.Push({std::move(msg), SceneUpdate::Kind::kDelta});
+    }
+  }
+
+  if (requestResync && !this->node.Request(this->service,
+      &Implementation::OnSceneSrvMsg, this))
+  {
+    this->OnSceneSrvMsg(msgs::Scene(), false);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnSceneSrvMsg(
+  const msgs::Scene &_msg, const bool result)
+{
+  if (!result)
+  {
+    gzerr << "Error making service request to " << this->service
+           << std::endl;
+  }
+
+  // Copy and compute the version before locking
+  msgs::Scene msg;
+  std::string version;
+  if (result)
+  {
+    msg = _msg;
+    if (!this->sceneCache.empty())
+      version = SceneSnapshot::Version(_msg);
+  }
+
+  bool save{result && !this->sceneCache.empty()};
+  bool requestResync{false};
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+
+    // Replace the scene, then apply the deltas received since. If the
+    // request failed, apply the deltas anyway, the gap can't be recovered.
+    std::optional<std::uint64_t> snapshotSeq;
+    if (result)
+    {
+      snapshotSeq = sceneSeq(_msg);
+      if (this->firstScene && !this->cachedVersion)
+      {
+        this->sceneMsgs.Push({std::move(msg), SceneUpdate::Kind::kAdd});
+      }
+      else if (this->firstScene && *this->cachedVersion == version)
+      {
+        // The cached scene is already shown and didn't change
+        gzmsg << "Cached scene is up to date" << std::endl;
+        save = false;
+      }
+      else
+      {
+        this->sceneMsgs.Push({std::move(msg), SceneUpdate::Kind::kSnapshot});
+      }
+    }
+    this->firstScene = false;
+    this->cachedVersion.reset();
+
+    // Deltas up to the scene's seq are already part of it
+    this->lastSceneSeq = snapshotSeq;
+    auto delta = this->resyncDeltas.begin();
+    for (; delta != this->resyncDeltas.end(); ++delta)
+    {
+      const std::uint64_t seq = delta->first;
+      if (this->lastSceneSeq && seq <= *this->lastSceneSeq)
+        continue;
+
+      if (result && this->lastSceneSeq && seq != *this->lastSceneSeq + 1u)
+      {
+        gzwarn << "Missed scene updates " << *this->lastSceneSeq + 1u
+               << " to " << seq - 1u << ", requesting the full scene"
+               << std::endl;
+        requestResync = true;
+        break;
+      }
+      this->sceneMsgs.Push({std::move(delta->second),
+          SceneUpdate::Kind::kDelta});
+      this->lastSceneSeq = seq;
+    }
+
+    // Keep waiting for a full scene with the deltas after the gap
+    this->resyncDeltas.erase(this->resyncDeltas.begin(), delta);
+    this->resyncing = requestResync;
+  }
+
+  // Save outside of the lock, so the render thread isn't blocked on disk
+  if (save)
+    SceneSnapshot::Write(this->sceneCache, _msg);
+
+  if (requestResync && !this->node.Request(this->service,
+      &Implementation::OnSceneSrvMsg, this))
+  {
+    this->OnSceneSrvMsg(msgs::Scene(), false);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ApplySceneUpdate(
+    SceneUpdate &&_update)
+{
+  std::vector<unsigned int> toDelete;
+  if (_update.kind == SceneUpdate::Kind::kSnapshot)
+  {
+    // Top level entities which were still being built are rebuilt
+    std::unordered_set<unsigned int> incomplete;
+    auto topLevel = [this](unsigned int _id)
+    {
+      while (auto slot = this->entities.Find(_id))
+      {
+        if (slot->parent == EntityRegistry<rendering::Node>::kNoParent)
+          break;
+        _id = slot->parent;
+      }
+      return _id;
+    };
+    for (const auto *queue : {&this->loadQueue, &this->meshWaiting})
+    {
+      for (const auto &item : *queue)
+      {
+        if (item.seq == 0u)
+          incomplete.insert(topLevel(item.parentId));
+      }
+    }
+    this->loadQueue.clear();
+    this->meshWaiting.clear();
+    this->loadTotal = 0u;
+    this->loadDone = 0u;
+
+    // Reconcile with the full scene: entities which are gone or changed
+    // are deleted, the others are kept and not loaded again
+    std::unordered_map<unsigned int, std::uint64_t> received;
+    for (const auto &model : _update.msg.model())
+      received[model.id()] = contentHash(model);
+    for (const auto &light : _update.msg.light())
+      received[light.id()] = contentHash(light);
+
+    std::unordered_set<unsigned int> unchanged;
+    this->entities.ForEach([&](const auto &_slot)
+    {
+      if (_slot.parent != EntityRegistry<rendering::Node>::kNoParent)
+        return;
+      auto it = received.find(_slot.id);
+      auto loaded = this->topLevelHashes.find(_slot.id);
+      if (it != received.end() && loaded != this->topLevelHashes.end() &&
+          it->second == loaded->second && incomplete.count(_slot.id) == 0u)
+      {
+        unchanged.insert(_slot.id);
+      }
+      else
+      {
+        toDelete.push_back(_slot.id);
+      }
+    });
+
+    auto changed = [&unchanged](const auto &_msg)
+    {
+      return unchanged.count(_msg.id()) == 0u;
+    };
+    keepIf(*_update.msg.mutable_model(), changed);
+    keepIf(*_update.msg.mutable_light(), changed);
+  }
+  else if (_update.kind == SceneUpdate::Kind::kDelta)
+  {
+    if (auto deleted = headerData(_update.msg, "deleted"))
+    {
+      for (const auto &value : *deleted)
+      {
+        try
+        {
+          toDelete.push_back(static_cast<unsigned int>(std::stoul(value)));
+        }
+        catch (...)
+        {
+          gzerr << "Invalid deleted entity id [" << value << "]"
+                << std::endl;
+        }
+      }
+    }
+
+    // Entities that already exist are replaced
+    for (const auto &model : _update.msg.model())
+      toDelete.push_back(model.id());
+    for (const auto &light : _update.msg.light())
+      toDelete.push_back(light.id());
+  }
+
+  if (!toDelete.empty())
+    this->DeleteEntities(toDelete);
+
+  this->LoadScene(std::make_shared<const msgs::Scene>(
+      std::move(_update.msg)));
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the entities which will be created for a model
+/// \param[in] _msg Model msg
+/// \return Number of models, links, visuals and lights
+static std::size_t entityCount(const msgs::Model &_msg)
+{
+  std::size_t count{1u};
+  for (const auto &link : _msg.link())
+    count += 1u + link.visual_size() + link.light_size();
+  for (const auto &model : _msg.model())
+    count += entityCount(model);
+  return count;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::LoadScene(
+    std::shared_ptr<const msgs::Scene> _msg)
+{
+  rendering::VisualPtr rootVis = this->scene->RootVisual();
+
+  // load models
+  for (const auto &model : _msg->model())
+  {
+    this->loadQueue.push_back({&model, rootVis, ++this->loadSeq, _msg});
+
+    // Lazy models are only queued as a proxy for now
+    if (this->lazy)
+    {
+      ++this->loadTotal;
+      continue;
+    }
+    this->PrefetchMeshes(model);
+    this->loadTotal += entityCount(model);
+  }
+
+  // load lights
+  for (const auto &light : _msg->light())
+  {
+    this->loadQueue.push_back({&light, rootVis, ++this->loadSeq, _msg});
+    ++this->loadTotal;
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::PrefetchMeshes(
+    const msgs::Model &_msg)
+{
+  for (const auto &link : _msg.link())
+  {
+    for (const auto &visual : link.visual())
+    {
+      if (visual.geometry().has_mesh() &&
+          !visual.geometry().mesh().filename().empty())
+      {
+        this->meshLoader.Prefetch(visual.geometry().mesh().filename());
+      }
+      if (auto lodMeshes = headerData(visual, "lod_mesh"))
+      {
+        for (const auto &file : *lodMeshes)
+          this->meshLoader.Prefetch(file);
+      }
+    }
+  }
+  for (const auto &model : _msg.model())
+    this->PrefetchMeshes(model);
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManager::Implementation::MeshesReady(const LoadItem &_item)
+{
+  auto visualMsg = std::get_if<const msgs::Visual *>(&_item.msg);
+  if (nullptr == visualMsg)
+    return true;
+
+  const msgs::Visual &msg = **visualMsg;
+  bool ready{true};
+  if (msg.geometry().has_mesh() && !msg.geometry().mesh().filename().empty())
+    ready = this->meshLoader.IsReady(msg.geometry().mesh().filename());
+
+  // Check every level, so they all start loading
+  if (auto lodMeshes = headerData(msg, "lod_mesh"))
+  {
+    for (const auto &file : *lodMeshes)
+      ready = this->meshLoader.IsReady(file) && ready;
+  }
+  return ready;
+}
+
+/////////////////////////////////////////////////
+std::size_t TransportSceneManager::Implementation::ProcessLoadQueue()
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t loaded{0u};
+  this->loadedIds.clear();
+
+  const std::size_t depth = this->loadQueue.size() + this->meshWaiting.size();
+  this->stats.Add(SceneStats::Metric::kLoadQueueDepth,
+      static_cast<double>(depth));
+  if (depth > 0u && !this->sceneLoadStart)
+    this->sceneLoadStart = start;
+
+  // Put visuals whose mesh is now in memory back at the front of the queue,
+  // keeping their order
+  if (!this->meshWaiting.empty())
+  {
+    std::deque<LoadItem> stillWaiting;
+    std::vector<LoadItem> ready;
+    for (auto &item : this->meshWaiting)
+    {
+      if (this->MeshesReady(item))
+        ready.push_back(std::move(item));
+      else
+        stillWaiting.push_back(std::move(item));
+    }
+    for (auto it = ready.rbegin(); it != ready.rend(); ++it)
+      this->loadQueue.push_front(std::move(*it));
+    this->meshWaiting.swap(stillWaiting);
+  }
+
+  while (!this->loadQueue.empty())
+  {
+    // Always make some progress, even if a single entity is over budget
+    if (this->maxLoadsPerFrame > 0u && loaded >= this->maxLoadsPerFrame)
+      break;
+    if (this->loadBudget.count() > 0 && loaded > 0u &&
+        std::chrono::steady_clock::now() - start >= this->loadBudget)
+    {
+      break;
+    }
+
+    LoadItem item = std::move(this->loadQueue.front());
+    this->loadQueue.pop_front();
+
+    // Don't block the render thread on mesh files, create other entities
+    // while the mesh loads
+    if (!this->MeshesReady(item))
+    {
+      this->meshWaiting.push_back(std::move(item));
+      continue;
+    }
+    ++this->loadDone;
+
+    if (this->LoadQueuedItem(item))
+    {
+      ++loaded;
+      const unsigned int id = std::visit(
+          [](const auto *_msg) { return _msg->id(); }, item.msg);
+      this->loadedIds.push_back(id);
+      if (this->spatialIndex)
+        this->MarkBoundsDirty(id);
+    }
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  if (depth > 0u)
   {
-    gzerr << "Error subscribing to scene topic: " << this->sceneTopic
-           << std::endl;
+    this->stats.Add(SceneStats::Metric::kFrameLoadTime,
+        std::chrono::duration<double, std::milli>(end - start).count());
+    this->stats.Add(SceneStats::Counter::kEntitiesLoaded, loaded);
   }
-  else
+
+  if (this->loadQueue.empty() && this->meshWaiting.empty())
   {
-    gzmsg << "Listening to scene messages on [" << this->sceneTopic << "]"
-           << std::endl;
+    this->loadTotal = 0u;
+    this->loadDone = 0u;
+    this->cancelledLoads.clear();
+
+    if (this->sceneLoadStart)
+    {
+      this->stats.Add(SceneStats::Metric::kSceneLoadTime,
+          std::chrono::duration<double, std::milli>(
+          end - *this->sceneLoadStart).count());
+      this->sceneLoadStart.reset();
+    }
   }
 
-  gzmsg << "Transport initialized." << std::endl;
+  return loaded;
 }
 
 /////////////////////////////////////////////////
-bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
+/// \brief Get the ids of the entities under a model
+/// \param[in] _msg Model msg
+/// \param[out] _ids Ids of its links, visuals, lights and nested models,
+/// and everything under them
+static void childIds(const msgs::Model &_msg, std::vector<unsigned int> &_ids)
 {
-  if (_event->type() == events::Render::kType)
+  for (const auto &link : _msg.link())
   {
-    this->dataPtr->OnRender();
+    _ids.push_back(link.id());
+    for (const auto &visual : link.visual())
+      _ids.push_back(visual.id());
+    for (const auto &light : link.light())
+      _ids.push_back(light.id());
+  }
+  for (const auto &model : _msg.model())
+  {
+    _ids.push_back(model.id());
+    childIds(model, _ids);
   }
+}
 
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+/////////////////////////////////////////////////
+/// \brief Get the radius of a sphere around a geometry's origin which
+/// contains it
+/// \param[in] _msg Geometry msg
+/// \return Radius, zero for meshes and other geometries whose size isn't
+/// part of the msg
+static double geometryRadius(const msgs::Geometry &_msg)
+{
+  if (_msg.has_box())
+    return msgs::Convert(_msg.box().size()).Length() * 0.5;
+  if (_msg.has_sphere())
+    return _msg.sphere().radius();
+  if (_msg.has_cylinder())
+    return std::hypot(_msg.cylinder().radius(), _msg.cylinder().length() * 0.5);
+  if (_msg.has_cone())
+    return std::hypot(_msg.cone().radius(), _msg.cone().length() * 0.5);
+  if (_msg.has_capsule())
+    return _msg.capsule().radius() + _msg.capsule().length() * 0.5;
+  if (_msg.has_ellipsoid())
+    return msgs::Convert(_msg.ellipsoid().radii()).Max();
+  if (_msg.has_plane())
+    return msgs::Convert(_msg.plane().size()).Length() * 0.5;
+  return 0.0;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::Request()
+/// \brief Get the radius of a sphere around a model's origin which contains
+/// all of its visuals. Offsets are added up without rotating them, which
+/// overestimates the radius but never cuts a visual off.
+/// \param[in] _msg Model msg
+/// \return Radius
+static double boundingRadius(const msgs::Model &_msg)
 {
-  // wait for the service to be advertized
-  std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
+  double radius{0.0};
+  for (const auto &link : _msg.link())
   {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
-    gzdbg << "Waiting for service [" << this->service << "]\n";
+    const double linkOffset = msgs::Convert(link.pose().position()).Length();
+    for (const auto &visual : link.visual())
+    {
+      radius = std::max(radius, linkOffset +
+          msgs::Convert(visual.pose().position()).Length() +
+          geometryRadius(visual.geometry()));
+    }
   }
-
-  if (publishers.empty() || !this->node.Request(this->service,
-      &Implementation::OnSceneSrvMsg, this))
+  for (const auto &model : _msg.model())
   {
-    gzerr << "Error making service request to [" << this->service << "]"
-           << std::endl;
+    radius = std::max(radius, msgs::Convert(model.pose().position()).Length() +
+        boundingRadius(model));
   }
+  return radius;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnPoseVMsg(const msgs::Pose_V &_msg)
+bool TransportSceneManager::Implementation::FindCamera()
 {
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  for (int i = 0; i < _msg.pose_size(); ++i)
-  {
-    math::Pose3d pose = msgs::Convert(_msg.pose(i));
+  if (nullptr != this->camera)
+    return true;
 
-    // apply additional local poses if available
-    const auto it = this->localPoses.find(_msg.pose(i).id());
-    if (it != this->localPoses.end())
+  for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
+  {
+    auto cam = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->NodeByIndex(i));
+    if (nullptr != cam)
     {
-      pose = pose * it->second;
+      this->camera = cam;
+      gzdbg << "TransportSceneManager using camera ["
+             << this->camera->Name() << "]" << std::endl;
+      return true;
     }
-
-    this->poses[_msg.pose(i).id()] = pose;
   }
+  return false;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnDeletionMsg(
-  const msgs::UInt32_V &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
-}
-
-/////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnRender()
+void TransportSceneManager::Implementation::UpdateLevelsOfDetail()
 {
-  if (nullptr == this->scene)
-  {
-    this->scene = rendering::sceneFromFirstRenderEngine();
-    if (nullptr == this->scene)
-      return;
-
-    this->initializeTransport = std::thread(
-        &Implementation::InitializeTransport, this);
-  }
+  if (!this->FindCamera())
+    return;
 
-  std::lock_guard<std::mutex> lock(this->msgMutex);
+  const double aspect = this->camera->AspectRatio();
+  const double fovY = aspect > 0.0 ?
+      2.0 * std::atan(std::tan(this->camera->HFOV().Radian() * 0.5) / aspect) :
+      this->camera->HFOV().Radian();
+  const math::Vector3d cameraPos = this->camera->WorldPosition();
 
-  for (const auto &msg : this->sceneMsgs)
+  for (auto &[id, lodVisual] : this->lodVisuals)
   {
-    this->LoadScene(msg);
-  }
-  this->sceneMsgs.clear();
+    auto visual = lodVisual.visual.lock();
+    if (!visual)
+      continue;
+
+    const double distance = cameraPos.Distance(visual->WorldPosition());
+    const std::size_t previous = lodVisual.lod.Level();
+    if (!lodVisual.lod.Update(LevelOfDetail::ScreenSize(lodVisual.radius,
+        distance, fovY)))
+    {
+      continue;
+    }
 
-  for (const auto &entity : this->toDeleteEntities)
-  {
-    this->DeleteEntity(entity);
+    if (auto level = lodVisual.levels[previous].lock())
+      level->SetVisible(false);
+    if (auto level = lodVisual.levels[lodVisual.lod.Level()].lock())
+      level->SetVisible(true);
   }
-  this->toDeleteEntities.clear();
+}
 
-  for (auto pIt = this->poses.begin(); pIt != this->poses.end();)
-  {
-    auto vIt = this->visuals.find(pIt->first);
-    if (vIt != this->visuals.end())
-    {
-      auto visual = vIt->second.lock();
-      if (visual)
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateLazyModels()
+{
+  if (this->lazyModels.Size() == 0u || !this->FindCamera())
+    return;
+
+  std::vector<unsigned int> collapsed;
+  std::vector<std::pair<unsigned int, math::Pose3d>> collapsedPoses;
+  this->lazyModels.Update(this->camera->WorldPosition(),
+      [this](unsigned int _id, math::Vector3d &_pos)
       {
-        visual->SetLocalPose(pIt->second);
-      }
-      else
+        const auto *slot = this->entities.Find(_id);
+        if (nullptr == slot)
+          return false;
+        auto node = slot->node.lock();
+        if (!node)
+          return false;
+        _pos = node->WorldPosition();
+        return true;
+      },
+      [this](unsigned int _id, const LazyModel &_model,
+             std::uint64_t _generation)
       {
-        this->visuals.erase(vIt);
-      }
-      this->poses.erase(pIt++);
-    }
-    else
-    {
-      auto lIt = this->lights.find(pIt->first);
-      if (lIt != this->lights.end())
+        this->ExpandModel(_id, _model, _generation);
+      },
+      [this, &collapsed, &collapsedPoses](unsigned int _id,
+          const LazyModel &_model)
       {
-        auto light = lIt->second.lock();
-        if (light)
+        // Keep the model itself as a proxy, release everything under it
+        if (const auto *slot = this->entities.Find(_id))
         {
-          light->SetLocalPose(pIt->second);
+          collapsed.insert(collapsed.end(), slot->children.begin(),
+              slot->children.end());
         }
-        else
+
+        // Publishers may only send poses which change, so the entities
+        // are rebuilt where they were, not where the msg spawned them
+        for (const auto id : _model.children)
         {
-          this->lights.erase(lIt);
+          const auto *child = this->entities.Find(id);
+          if (nullptr != child && child->hasAppliedPose)
+          {
+            collapsedPoses.emplace_back(id,
+                child->appliedPose * child->localPose.Inverse());
+          }
         }
-        this->poses.erase(pIt++);
-      }
-      else
-      {
-        ++pIt;
-      }
-    }
-  }
+      });
 
-  // Note we are clearing the pose msgs here but later on we may need to
-  // consider the case where pose msgs arrive before scene/visual msgs
-  this->poses.clear();
-}
+  if (!collapsed.empty())
+    this->DeleteEntities(collapsed);
 
-/////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnSceneMsg(const msgs::Scene &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  this->sceneMsgs.push_back(_msg);
+  for (const auto &[id, pose] : collapsedPoses)
+    this->lazyPoses[id] = pose;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnSceneSrvMsg(
-  const msgs::Scene &_msg, const bool result)
+void TransportSceneManager::Implementation::ExpandModel(unsigned int _id,
+    const LazyModel &_model, std::uint64_t _generation)
 {
-  if (!result)
-  {
-    gzerr << "Error making service request to " << this->service
-           << std::endl;
+  rendering::VisualPtr modelVis = _model.visual.lock();
+  if (!modelVis)
     return;
-  }
 
+  this->PrefetchMeshes(*_model.msg);
+  const msgs::Model &msg = *_model.msg;
+  const std::uint64_t seq = ++this->loadSeq;
+  for (int i = 0; i < msg.link_size(); ++i)
   {
-    std::lock_guard<std::mutex> lock(this->msgMutex);
-    this->sceneMsgs.push_back(_msg);
+    this->loadQueue.push_back({&msg.link(i), modelVis, 0u, _model.scene,
+        _id, _id, _generation, seq});
   }
+  for (int i = 0; i < msg.model_size(); ++i)
+  {
+    this->loadQueue.push_back({&msg.model(i), modelVis, 0u, _model.scene,
+        _id, _id, _generation, seq});
+  }
+  this->loadTotal += entityCount(msg) - 1u;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::LoadScene(const msgs::Scene &_msg)
+bool TransportSceneManager::Implementation::LoadQueuedItem(
+    const LoadItem &_item)
 {
-  rendering::VisualPtr rootVis = this->scene->RootVisual();
+  // The parent was deleted while this entity was queued
+  rendering::VisualPtr parent = _item.parent.lock();
+  if (!parent)
+    return false;
+
+  // The lazy model it belongs to was released while this entity was queued
+  if (_item.lazyRoot != EntityRegistry<rendering::Node>::kNoParent &&
+      !this->lazyModels.IsCurrent(_item.lazyRoot, _item.lazyGeneration))
+  {
+    return false;
+  }
 
-  // load models
-  for (int i = 0; i < _msg.model_size(); ++i)
+  // Nested entities are cancelled by the sequence number of the load they
+  // were queued from
+  const std::uint64_t rootSeq = _item.seq != 0u ? _item.seq : _item.rootSeq;
+  auto cancelled = [this, rootSeq](unsigned int _id)
   {
     // Only add if it's not already loaded
-    if (this->visuals.find(_msg.model(i).id()) == this->visuals.end())
+    if (this->entities.Contains(_id))
+      return true;
+
+    auto it = this->cancelledLoads.find(_id);
+    return it != this->cancelledLoads.end() && rootSeq <= it->second;
+  };
+
+  if (auto modelMsg = std::get_if<const msgs::Model *>(&_item.msg))
+  {
+    const msgs::Model &msg = **modelMsg;
+    if (cancelled(msg.id()))
+      return false;
+
+    rendering::VisualPtr modelVis = this->LoadModel(msg, _item.parentId);
+    if (!modelVis)
     {
-      rendering::VisualPtr modelVis = this->LoadModel(_msg.model(i));
-      if (modelVis)
-        rootVis->AddChild(modelVis);
-      else
-        gzerr << "Failed to load model: " << _msg.model(i).name() << std::endl;
+      gzerr << "Failed to load " << (_item.seq == 0u ? "nested model: " :
+          "model: ") << msg.name() << std::endl;
+      return false;
+    }
+    parent->AddChild(modelVis);
+    if (_item.seq != 0u)
+      this->topLevelHashes[msg.id()] = contentHash(msg);
+
+    // Top level models are built once the camera gets close
+    if (this->lazy && _item.seq != 0u)
+    {
+      LazyModel lazyModel{&msg, modelVis, _item.scene, {}};
+      childIds(msg, lazyModel.children);
+
+      // Poses of its entities are kept until it's built
+      math::Pose3d pose;
+      for (const auto id : lazyModel.children)
+      {
+        this->lazyChildren[id] = msg.id();
+        if (this->pendingPoses.Take(id, pose))
+          this->lazyPoses[id] = pose;
+      }
+      this->lazyModels.Add(msg.id(), boundingRadius(msg),
+          std::move(lazyModel));
+      return true;
     }
+
+    // Queue links, then nested models, ahead of everything else so models
+    // are completed one at a time
+    for (int i = msg.model_size() - 1; i >= 0; --i)
+      this->loadQueue.push_front({&msg.model(i), modelVis, 0u, _item.scene,
+          msg.id(), _item.lazyRoot, _item.lazyGeneration, rootSeq});
+    for (int i = msg.link_size() - 1; i >= 0; --i)
+      this->loadQueue.push_front({&msg.link(i), modelVis, 0u, _item.scene,
+          msg.id(), _item.lazyRoot, _item.lazyGeneration, rootSeq});
+    return true;
   }
 
-  // load lights
-  for (int i = 0; i < _msg.light_size(); ++i)
+  if (auto linkMsg = std::get_if<const msgs::Link *>(&_item.msg))
+  {
+    const msgs::Link &msg = **linkMsg;
+    if (cancelled(msg.id()))
+      return false;
+
+    rendering::VisualPtr linkVis = this->LoadLink(msg, _item.parentId);
+    if (!linkVis)
+    {
+      gzerr << "Failed to load link: " << msg.name() << std::endl;
+      return false;
+    }
+    parent->AddChild(linkVis);
+
+    // Queue visuals, then lights
+    for (int i = msg.light_size() - 1; i >= 0; --i)
+      this->loadQueue.push_front({&msg.light(i), linkVis, 0u, _item.scene,
+          msg.id(), _item.lazyRoot, _item.lazyGeneration, rootSeq});
+    for (int i = msg.visual_size() - 1; i >= 0; --i)
+      this->loadQueue.push_front({&msg.visual(i), linkVis, 0u, _item.scene,
+          msg.id(), _item.lazyRoot, _item.lazyGeneration, rootSeq});
+    return true;
+  }
+
+  if (auto visualMsg = std::get_if<const msgs::Visual *>(&_item.msg))
   {
-    if (this->lights.find(_msg.light(i).id()) == this->lights.end())
+    const msgs::Visual &msg = **visualMsg;
+    if (cancelled(msg.id()))
+      return false;
+
+    rendering::VisualPtr visualVis = this->LoadVisual(msg, _item.parentId);
+    if (!visualVis)
     {
-      rendering::LightPtr light = this->LoadLight(_msg.light(i));
-      if (light)
-        rootVis->AddChild(light);
-      else
-        gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+      gzerr << "Failed to load visual: " << msg.name() << std::endl;
+      return false;
     }
+    parent->AddChild(visualVis);
+    return true;
+  }
+
+  const msgs::Light &msg = *std::get<const msgs::Light *>(_item.msg);
+  if (cancelled(msg.id()))
+    return false;
+
+  rendering::LightPtr light = this->LoadLight(msg, _item.parentId);
+  if (!light)
+  {
+    gzerr << "Failed to load light: " << msg.name() << std::endl;
+    return false;
   }
+  parent->AddChild(light);
+  if (_item.seq != 0u)
+    this->topLevelHashes[msg.id()] = contentHash(msg);
+  return true;
 }
 
 /////////////////////////////////////////////////
 rendering::VisualPtr TransportSceneManager::Implementation::LoadModel(
-    const msgs::Model &_msg)
+    const msgs::Model &_msg, unsigned int _parentId)
 {
   rendering::VisualPtr modelVis;
   if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
@@ -508,35 +2369,14 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadModel(
 
   if (_msg.has_pose())
     modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = modelVis;
-
-  // load links
-  for (int i = 0; i < _msg.link_size(); ++i)
-  {
-    rendering::VisualPtr linkVis = this->LoadLink(_msg.link(i));
-    if (linkVis)
-      modelVis->AddChild(linkVis);
-    else
-      gzerr << "Failed to load link: " << _msg.link(i).name() << std::endl;
-  }
-
-  // load nested models
-  for (int i = 0; i < _msg.model_size(); ++i)
-  {
-    rendering::VisualPtr nestedModelVis = this->LoadModel(_msg.model(i));
-    if (nestedModelVis)
-      modelVis->AddChild(nestedModelVis);
-    else
-      gzerr << "Failed to load nested model: " << _msg.model(i).name()
-             << std::endl;
-  }
+  this->entities.Add(_msg.id(), EntityType::kVisual, modelVis, _parentId);
 
   return modelVis;
 }
 
 /////////////////////////////////////////////////
 rendering::VisualPtr TransportSceneManager::Implementation::LoadLink(
-    const msgs::Link &_msg)
+    const msgs::Link &_msg, unsigned int _parentId)
 {
   rendering::VisualPtr linkVis;
   if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
@@ -550,34 +2390,14 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadLink(
 
   if (_msg.has_pose())
     linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = linkVis;
-
-  // load visuals
-  for (int i = 0; i < _msg.visual_size(); ++i)
-  {
-    rendering::VisualPtr visualVis = this->LoadVisual(_msg.visual(i));
-    if (visualVis)
-      linkVis->AddChild(visualVis);
-    else
-      gzerr << "Failed to load visual: " << _msg.visual(i).name() << std::endl;
-  }
-
-  // load lights
-  for (int i = 0; i < _msg.light_size(); ++i)
-  {
-    rendering::LightPtr light = this->LoadLight(_msg.light(i));
-    if (light)
-      linkVis->AddChild(light);
-    else
-      gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
-  }
+  this->entities.Add(_msg.id(), EntityType::kVisual, linkVis, _parentId);
 
   return linkVis;
 }
 
 /////////////////////////////////////////////////
 rendering::VisualPtr TransportSceneManager::Implementation::LoadVisual(
-    const msgs::Visual &_msg)
+    const msgs::Visual &_msg, unsigned int _parentId)
 {
   if (!_msg.has_geometry())
     return rendering::VisualPtr();
@@ -592,91 +2412,227 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadVisual(
     visualVis = this->scene->CreateVisual();
   }
 
-  this->visuals[_msg.id()] = visualVis;
-
-  math::Vector3d scale = math::Vector3d::One;
-  math::Pose3d localPose;
-  rendering::GeometryPtr geom =
-      this->LoadGeometry(_msg.geometry(), scale, localPose);
-
-  if (_msg.has_pose())
-    visualVis->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
-  else
-    visualVis->SetLocalPose(localPose);
-
-  if (geom)
+  this->entities.Add(_msg.id(), EntityType::kVisual, visualVis,
+      _parentId);
+
+  // Coarser levels of detail, listed in the msg header as meshes together
+  // with the screen size below which each one is used
+  std::vector<msgs::Geometry> levels;
+  std::vector<double> screenSizes;
+  auto lodMeshes = headerData(_msg, "lod_mesh");
+  auto lodSizes = headerData(_msg, "lod_screen_size");
+  if (nullptr != lodMeshes && nullptr != lodSizes &&
+      lodMeshes->size() == lodSizes->size())
   {
-    // store the local pose
-    this->localPoses[_msg.id()] = localPose;
-
-    visualVis->AddGeometry(geom);
-    visualVis->SetLocalScale(scale);
-
-    // set material
-    rendering::MaterialPtr material{nullptr};
-    if (_msg.has_material())
-    {
-      material = this->LoadMaterial(_msg.material());
-    }
-    // Don't set a default material for meshes because they
-    // may have their own
-    // TODO(anyone) support overriding mesh material
-    else if (!_msg.geometry().has_mesh())
-    {
-      // create default material
-      material = this->scene->Material("gz-grey");
-      if (!material)
-      {
-        material = this->scene->CreateMaterial("gz-grey");
-        material->SetAmbient(0.3, 0.3, 0.3);
-        material->SetDiffuse(0.7, 0.7, 0.7);
-        material->SetSpecular(1.0, 1.0, 1.0);
-        material->SetRoughness(0.2f);
-        material->SetMetalness(1.0f);
-      }
-    }
-    else
+    try
     {
-      // meshes created by mesh loader may have their own materials
-      // update/override their properties based on input sdf element values
-      auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
-      for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+      for (int i = 0; i < lodMeshes->size(); ++i)
       {
-        auto submesh = mesh->SubMeshByIndex(i);
-        auto submeshMat = submesh->Material();
-        if (submeshMat)
+        msgs::Geometry level;
+        level.set_type(msgs::Geometry::MESH);
+        level.mutable_mesh()->set_filename(lodMeshes->Get(i));
+        if (_msg.geometry().has_mesh())
+        {
+          *level.mutable_mesh()->mutable_scale() =
+              _msg.geometry().mesh().scale();
+        }
+        else
         {
-          double productAlpha = (1.0-_msg.transparency()) *
-              (1.0 - submeshMat->Transparency());
-          submeshMat->SetTransparency(1 - productAlpha);
-          submeshMat->SetCastShadows(_msg.cast_shadows());
+          msgs::Set(level.mutable_mesh()->mutable_scale(),
+              math::Vector3d::One);
         }
+        levels.push_back(level);
+        screenSizes.push_back(std::stod(lodSizes->Get(i)));
       }
     }
+    catch (...)
+    {
+      screenSizes.clear();
+    }
+    if (screenSizes.empty() || !LevelOfDetail::Valid(screenSizes))
+    {
+      gzerr << "Invalid levels of detail for visual [" << _msg.name()
+            << "], expected screen sizes in decreasing order" << std::endl;
+      levels.clear();
+      screenSizes.clear();
+    }
+  }
+  else if (nullptr != lodMeshes || nullptr != lodSizes)
+  {
+    gzerr << "Visual [" << _msg.name() << "] needs as many <lod_mesh> as "
+          << "<lod_screen_size> header values" << std::endl;
+  }
 
-    if (material)
+  // Replace distant meshes by a box of their bounds
+  std::optional<math::Pose3d> proxyPose;
+  const msgs::Geometry coarsest = levels.empty() ? _msg.geometry() :
+      levels.back();
+  if (this->lodProxyScreenSize > 0.0 && coarsest.has_mesh() &&
+      (screenSizes.empty() || this->lodProxyScreenSize < screenSizes.back()))
+  {
+    if (const common::Mesh *mesh =
+        this->meshLoader.Mesh(coarsest.mesh().filename()))
     {
-      // set transparency
-      material->SetTransparency(_msg.transparency());
+      math::Vector3d center, min, max;
+      mesh->AABB(center, min, max);
+      const math::Vector3d scale = msgs::Convert(coarsest.mesh().scale());
+
+      msgs::Geometry proxy;
+      proxy.set_type(msgs::Geometry::BOX);
+      msgs::Set(proxy.mutable_box()->mutable_size(), (max - min) * scale);
+      levels.push_back(proxy);
+      screenSizes.push_back(this->lodProxyScreenSize);
+      proxyPose = math::Pose3d(center * scale, math::Quaterniond::Identity);
+    }
+  }
 
-      // cast shadows
-      material->SetCastShadows(_msg.cast_shadows());
+  if (_msg.has_pose())
+    visualVis->SetLocalPose(msgs::Convert(_msg.pose()));
 
-      geom->SetMaterial(material);
-      // todo(anyone) SetMaterial function clones the input material.
-      // but does not take ownership of it so we need to destroy it here.
-      // This is not ideal. We should let gz-rendering handle the lifetime
-      // of this material
-      this->scene->DestroyMaterial(material);
+  if (levels.empty())
+  {
+    math::Pose3d localPose;
+    if (this->AddGeometry(_msg, _msg.geometry(), visualVis, _msg.id(),
+        localPose))
+    {
+      // store the local pose
+      this->entities.SetLocalPose(_msg.id(), localPose);
+      visualVis->SetLocalPose(visualVis->LocalPose() * localPose);
     }
+    return visualVis;
+  }
+
+  // Each level is a child visual, and only the current one is visible
+  LodVisual lodVisual;
+  lodVisual.lod = LevelOfDetail(std::move(screenSizes));
+  lodVisual.visual = visualVis;
+  levels.insert(levels.begin(), _msg.geometry());
+  for (std::size_t i = 0u; i < levels.size(); ++i)
+  {
+    rendering::VisualPtr levelVis = this->scene->CreateVisual();
+    math::Pose3d localPose;
+    this->AddGeometry(_msg, levels[i], levelVis, _msg.id(), localPose);
+    if (proxyPose && i + 1u == levels.size())
+      localPose = *proxyPose * localPose;
+    levelVis->SetLocalPose(localPose);
+    levelVis->SetVisible(i == 0u);
+    visualVis->AddChild(levelVis);
+    lodVisual.levels.push_back(levelVis);
   }
+
+  // The most detailed level decides the size on screen
+  const math::AxisAlignedBox box = lodVisual.levels[0].lock()->BoundingBox();
+  if (box.Min().X() <= box.Max().X())
+    lodVisual.radius = box.Size().Length() * 0.5;
   else
+    lodVisual.radius = geometryRadius(_msg.geometry());
+  this->lodVisuals[_msg.id()] = std::move(lodVisual);
+
+  return visualVis;
+}
+
+/////////////////////////////////////////////////
+rendering::GeometryPtr TransportSceneManager::Implementation::AddGeometry(
+    const msgs::Visual &_msg, const msgs::Geometry &_geometry,
+    const rendering::VisualPtr &_visual, unsigned int _user,
+    math::Pose3d &_localPose)
+{
+  math::Vector3d scale = math::Vector3d::One;
+  rendering::GeometryPtr geom =
+      this->LoadGeometry(_geometry, scale, _localPose);
+  if (!geom)
   {
     gzerr << "Failed to load geometry for visual: " << _msg.name()
            << std::endl;
+    return geom;
   }
 
-  return visualVis;
+  _visual->AddGeometry(geom);
+  _visual->SetLocalScale(scale);
+
+  // set material
+  // Don't set a default material for meshes because they
+  // may have their own
+  // TODO(anyone) support overriding mesh material
+  if (_msg.has_material() || !_geometry.has_mesh())
+  {
+    // Shared with other visuals, so it's not cloned
+    rendering::MaterialPtr material = this->AcquireMaterial(_msg, _user);
+    if (material)
+      geom->SetMaterial(material, false);
+    return geom;
+  }
+
+  // meshes created by mesh loader may have their own materials
+  // update/override their properties based on input sdf element values
+  auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
+  for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+  {
+    auto submesh = mesh->SubMeshByIndex(i);
+    auto submeshMat = submesh->Material();
+    if (submeshMat)
+    {
+      double productAlpha = (1.0-_msg.transparency()) *
+          (1.0 - submeshMat->Transparency());
+      submeshMat->SetTransparency(1 - productAlpha);
+      submeshMat->SetCastShadows(_msg.cast_shadows());
+    }
+  }
+  return geom;
+}
+
+/////////////////////////////////////////////////
+rendering::MaterialPtr TransportSceneManager::Implementation::AcquireMaterial(
+    const msgs::Visual &_msg, unsigned int _user)
+{
+  // Everything the material is built from. Transparency and shadows are
+  // part of the visual msg, not the material msg.
+  std::string key;
+  if (_msg.has_material())
+    key = "msg:" + _msg.material().SerializeAsString();
+  else
+    key = "default:";
+  const double transparency = _msg.transparency();
+  key.append(reinterpret_cast<const char *>(&transparency),
+      sizeof(transparency));
+  key.push_back(_msg.cast_shadows() ? '1' : '0');
+
+  return this->materials.Acquire(key, _user,
+      [this, &_msg]()
+      {
+        rendering::MaterialPtr material;
+        if (_msg.has_material())
+        {
+          material = this->LoadMaterial(_msg.material());
+        }
+        else
+        {
+          // create default material
+          material = this->scene->CreateMaterial();
+          material->SetAmbient(0.3, 0.3, 0.3);
+          material->SetDiffuse(0.7, 0.7, 0.7);
+          material->SetSpecular(1.0, 1.0, 1.0);
+          material->SetRoughness(0.2f);
+          material->SetMetalness(1.0f);
+        }
+
+        // set transparency
+        material->SetTransparency(_msg.transparency());
+
+        // cast shadows
+        material->SetCastShadows(_msg.cast_shadows());
+        return material;
+      });
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ReleaseMaterials(
+    unsigned int _id)
+{
+  this->materials.Release(_id, [this](rendering::MaterialPtr _material)
+  {
+    this->scene->DestroyMaterial(_material);
+  });
 }
 
 /////////////////////////////////////////////////
@@ -763,9 +2719,8 @@ rendering::GeometryPtr TransportSceneManager::Implementation::LoadGeometry(
     // Assume absolute path to mesh file
     descriptor.meshName = _msg.mesh().filename();
 
-    gz::common::MeshManager* meshManager =
-        gz::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
+    // Usually already loaded in the background by meshLoader
+    descriptor.mesh = this->meshLoader.Mesh(descriptor.meshName);
     geom = this->scene->CreateMesh(descriptor);
 
     scale = msgs::Convert(_msg.mesh().scale());
@@ -806,7 +2761,7 @@ rendering::MaterialPtr TransportSceneManager::Implementation::LoadMaterial(
 
 /////////////////////////////////////////////////
 rendering::LightPtr TransportSceneManager::Implementation::LoadLight(
-    const msgs::Light &_msg)
+    const msgs::Light &_msg, unsigned int _parentId)
 {
   rendering::LightPtr light;
 
@@ -856,32 +2811,102 @@ rendering::LightPtr TransportSceneManager::Implementation::LoadLight(
 
   light->SetCastShadows(_msg.cast_shadows());
 
-  this->lights[_msg.id()] = light;
+  this->entities.Add(_msg.id(), EntityType::kLight, light, _parentId);
+  this->lightActivity.Add(_msg.id(), _msg.cast_shadows());
   return light;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::DeleteEntity(
-  const unsigned int _entity)
+void TransportSceneManager::Implementation::DeleteEntities(
+  const std::vector<unsigned int> &_entities)
 {
-  if (this->visuals.find(_entity) != this->visuals.end())
+  // Take all subtrees out of the registry first, then destroy them
+  std::vector<rendering::NodePtr> roots;
+  for (const auto entity : _entities)
   {
-    auto visual = this->visuals[_entity].lock();
-    if (visual)
+    this->pendingPoses.Erase(entity);
+    this->lazyPoses.erase(entity);
+
+    const auto *slot = this->entities.Find(entity);
+    if (nullptr == slot)
     {
-      this->scene->DestroyVisual(visual, true);
+      // Don't load it if it's still queued or waiting for its meshes
+      if (!this->loadQueue.empty() || !this->meshWaiting.empty())
+        this->cancelledLoads[entity] = this->loadSeq;
+      continue;
     }
-    this->visuals.erase(_entity);
+
+    if (auto node = slot->node.lock())
+      roots.push_back(node);
+
+    this->entities.RemoveSubtree(entity, [this](const auto &_slot)
+    {
+      this->ForgetEntity(_slot);
+    });
   }
-  else if (this->lights.find(_entity) != this->lights.end())
+
+  for (const auto &node : roots)
   {
-    auto light = this->lights[_entity].lock();
-    if (light)
-    {
+    if (auto visual = std::dynamic_pointer_cast<rendering::Visual>(node))
+      this->scene->DestroyVisual(visual, true);
+    else if (auto light = std::dynamic_pointer_cast<rendering::Light>(node))
       this->scene->DestroyLight(light, true);
+  }
+
+  // Release the materials of the whole subtrees once they're gone
+  for (const auto id : this->removedVisuals)
+    this->ReleaseMaterials(id);
+  this->removedVisuals.clear();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ForgetEntity(
+    const EntityRegistry<rendering::Node>::Slot &_slot)
+{
+  this->pendingPoses.Erase(_slot.id);
+  this->interpolator.Erase(_slot.id);
+  if (const LazyModel *lazyModel = this->lazyModels.Find(_slot.id))
+  {
+    for (const auto id : lazyModel->children)
+    {
+      auto it = this->lazyChildren.find(id);
+      if (it != this->lazyChildren.end() && it->second == _slot.id)
+        this->lazyChildren.erase(it);
+      this->lazyPoses.erase(id);
     }
-    this->lights.erase(_entity);
+    this->lazyModels.Erase(_slot.id);
   }
+  this->lodVisuals.erase(_slot.id);
+  this->topLevelHashes.erase(_slot.id);
+  if (_slot.type == EntityType::kLight)
+    this->lightActivity.Erase(_slot.id);
+  if (this->spatialIndex)
+    this->spatialIndex->Remove(_slot.id);
+  if (_slot.type == EntityType::kVisual)
+    this->removedVisuals.push_back(_slot.id);
+}
+
+/////////////////////////////////////////////////
+QString TransportSceneManager::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  return this->dataPtr->statsSummary;
+}
+
+/////////////////////////////////////////////////
+double TransportSceneManager::LoadProgress() const
+{
+  return this->dataPtr->loadProgress;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::SetLoadProgress(double _progress)
+{
+  if (_progress == this->dataPtr->loadProgress)
+    return;
+
+  this->dataPtr->loadProgress = _progress;
+  emit this->LoadProgressChanged();
 }
 }  // namespace gz::gui::plugins
 
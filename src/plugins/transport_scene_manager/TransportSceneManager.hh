@@ -29,6 +29,14 @@ namespace gz::gui::plugins
   /// \brief Provides a Gazebo Transport interface to
   /// `gz::gui::plugins::MinimalScene`.
   ///
+  /// Several instances can be loaded to mirror different scenes, each with
+  /// its own service and topics. Entity ids and visual names aren't
+  /// namespaced per instance, so instances mirroring different worlds need
+  /// different scenes. Transport is initialized in the background by a
+  /// small worker pool shared by all instances in the process. While an
+  /// instance waits for its scene service it doesn't hold a thread, it
+  /// queues a check on the pool every few frames.
+  ///
   /// ## Configuration
   ///
   /// * \<service\> : Name of service where this system will request a scene
@@ -39,10 +47,190 @@ namespace gz::gui::plugins
   ///                        Optional, defaults to "/delete".
   /// * \<scene_topic\> : Name of topic to receive scene updates. Optional,
   ///                     defaults to "/scene".
+  /// * \<scene\> : Name of the scene to populate, as set on the
+  ///               `MinimalScene` plugin's \<scene\>. Optional, defaults to
+  ///               the first scene of the first loaded render engine.
+  /// * \<scene_cache\> : File the scene received from the scene service is
+  ///                     saved to. On startup, the scene saved by the last
+  ///                     run is shown right away, and updated once the
+  ///                     scene service responds, unless the scene didn't
+  ///                     change. Scenes are compared by the value of a
+  ///                     "version" header data entry if the server sets
+  ///                     one, and by contents otherwise. Only the models
+  ///                     and lights which changed are reloaded. Optional,
+  ///                     scenes aren't cached by default.
+  /// * \<stats_topic\> : Name of topic to publish scene synchronization
+  ///                     statistics on, as `gz::msgs::Param`. Optional,
+  ///                     statistics are only shown in the plugin by default.
+  /// * \<stats_period\> : Statistics reporting period in seconds. Optional,
+  ///                      defaults to 1.
+  /// * \<max_pending_poses\> : Maximum number of entities whose poses are
+  ///                           kept while waiting for the entity to be
+  ///                           loaded. Optional, defaults to 10000. Set to 0
+  ///                           to drop poses of unknown entities.
+  /// * \<pending_pose_timeout\> : Time in seconds, measured in the pose
+  ///                              messages' time, after which a pose waiting
+  ///                              for its entity is discarded. Optional,
+  ///                              defaults to 5.
+  /// * \<load_budget_ms\> : Maximum time in milliseconds spent creating
+  ///                        entities from scene messages on each frame. Large
+  ///                        scenes are loaded over several frames, so the
+  ///                        UI stays responsive. Optional, defaults to 10.
+  ///                        Set to 0 to load whole scenes in one frame.
+  /// * \<dynamic_light_shadows\> : Whether lights keep casting shadows
+  ///                               while they're dynamic. Turning it off
+  ///                               saves re-rendering the shadow maps of
+  ///                               moving lights, and shadows come back once
+  ///                               the light settles. Optional, defaults to
+  ///                               true.
+  /// * \<light_settle_frames\> : Number of frames a dynamic light must not
+  ///                             move for to be static again. Optional,
+  ///                             defaults to 60.
+  /// * \<light_dynamic_moves\> : Number of frames a light must move on,
+  ///                             without pausing longer than
+  ///                             \<light_settle_frames\>, to become dynamic.
+  ///                             Optional, defaults to 3.
+  /// * \<spatial_index\> : Whether to keep the bounds of top level visuals
+  ///                       in a spatial index, so other plugins can find
+  ///                       entities by position by sending a
+  ///                       `gz::gui::events::SpatialQuery`. Entities are
+  ///                       identified by their entity id. Bounds are
+  ///                       updated on the frames the entity moves. Optional,
+  ///                       defaults to false.
+  /// * \<spatial_index_margin\> : Distance in meters boxes are enlarged by
+  ///                              in the spatial index. Optional, defaults
+  ///                              to 0.1.
+  /// * \<max_loads_per_frame\> : Maximum number of entities created on each
+  ///                             frame. Optional, defaults to 0, no limit.
+  /// * \<playout_delay_ms\> : Delay in milliseconds, in the pose messages'
+  ///                          time, at which poses are played out. When
+  ///                          set, poses are buffered and interpolated on
+  ///                          every frame, for smooth motion when poses
+  ///                          arrive at a lower or irregular rate. Poses
+  ///                          without a header stamp are applied as
+  ///                          received. Optional, defaults to 0, poses are
+  ///                          applied as received.
+  /// * \<pose_buffer_size\> : Number of poses buffered per entity for
+  ///                          interpolation. Optional, defaults to 4.
+  /// * \<pose_epsilon\> : Poses which moved less than this distance in
+  ///                      meters from the last pose applied to the same
+  ///                      entity, and rotated less than
+  ///                      \<pose_angular_epsilon\>, are skipped. Optional,
+  ///                      defaults to 0, only identical poses are skipped.
+  /// * \<pose_angular_epsilon\> : Rotation in radians below which poses
+  ///                              are skipped, together with
+  ///                              \<pose_epsilon\>. Optional, defaults to
+  ///                              0, only poses with the same rotation are
+  ///                              skipped.
+  /// * \<lazy_load_distance\> : Distance in meters from the user camera
+  ///                            within which top level models are built.
+  ///                            Models further away are only loaded as an
+  ///                            empty visual which follows the model's pose,
+  ///                            and their links are built once the camera
+  ///                            gets close. Distances are measured to a
+  ///                            sphere around the model estimated from its
+  ///                            geometries. Mesh sizes aren't known until
+  ///                            they're loaded, so only their origin is
+  ///                            taken into account. The last pose of each
+  ///                            entity of a model which isn't built is
+  ///                            kept until it's built, and doesn't count
+  ///                            towards \<max_pending_poses\>. Optional,
+  ///                            defaults to 0, models are built right away.
+  /// * \<lazy_unload_distance\> : Distance in meters from the user camera
+  ///                              beyond which built models are released
+  ///                              back to their empty visual. Must be at
+  ///                              least the load distance. Optional,
+  ///                              defaults to 1.25 times the load distance.
+  /// * \<lod_proxy_screen_size\> : Size on screen, as a fraction of the
+  ///                               viewport height, below which mesh
+  ///                               visuals are replaced by a box of their
+  ///                               bounds. Optional, defaults to 0, meshes
+  ///                               are never replaced.
+  ///
+  /// ## Incremental scene updates
+  ///
+  /// Scene messages on the scene topic normally only add entities which
+  /// don't exist yet. A scene message whose header has a "seq" data entry is
+  /// treated as a delta instead:
+  ///
+  /// * Models and lights in the message are added, replacing any existing
+  ///   entity with the same id.
+  /// * Entity ids listed as values of a "deleted" header data entry are
+  ///   removed, together with everything under them.
+  ///
+  /// "seq" must increase by one with each delta. Deltas received before
+  /// the scene service responds are applied on top of its response,
+  /// skipping the ones up to the "seq" of the response if it has one, and
+  /// the next delta must follow that "seq". When a gap is detected, the
+  /// full scene is requested again from the scene service, only the
+  /// models and lights which differ from it are reloaded, and the deltas
+  /// received in the meantime are applied on top of it the same way.
+  ///
+  /// ## Levels of detail
+  ///
+  /// A visual message can list coarser versions of its geometry in its
+  /// header, as "lod_mesh" data values with mesh files from the most to the
+  /// least detailed, and matching "lod_screen_size" values. Each level is
+  /// used while the visual's size on screen, as a fraction of the viewport
+  /// height, is below its screen size, which must decrease from one level
+  /// to the next. Levels are switched every frame based on the distance
+  /// to the user camera.
+  ///
+  /// ## Lights
+  ///
+  /// Lights start static. A light becomes dynamic once its pose changed on
+  /// \<light_dynamic_moves\> frames without pausing longer than
+  /// \<light_settle_frames\>, and static again after not moving for that
+  /// long. When \<dynamic_light_shadows\> is turned off, dynamic lights
+  /// don't cast shadows, so a light which is only placed once keeps its
+  /// shadows, while a moving one doesn't invalidate its shadow maps on
+  /// every frame.
+  ///
+  /// ## Statistics
+  ///
+  /// Counters and histograms are collected over each reporting period and
+  /// then reset. Counters are published as int params with the number of
+  /// events, plus "<name>_per_sec" double params:
+  ///
+  /// * pose_msgs: Pose messages received.
+  /// * poses_applied: Poses written to the scene.
+  /// * poses_skipped: Poses skipped because the entity didn't move.
+  /// * poses_dropped: Poses of entities which weren't loaded in time.
+  /// * scene_msgs: Scene messages received.
+  /// * scene_msgs_merged: Scene messages merged with another one before
+  ///   being applied.
+  /// * entities_loaded: Entities created.
+  ///
+  /// Each histogram is a child param named by its "name" param, with
+  /// "count", "mean", "p50", "p90", "p99" and "max" values, and the
+  /// number of values in each bucket as "le_<upper bound>" params:
+  ///
+  /// * pose_age_ms: Time from receiving a pose message to applying it.
+  /// * frame_load_time_ms: Time spent creating entities on a frame.
+  /// * scene_load_time_ms: Time from the first frame loading queued
+  ///   entities to the queue being empty.
+  /// * load_queue_depth: Number of entities waiting to be created, sampled
+  ///   every frame.
   class TransportSceneManager : public Plugin
   {
     Q_OBJECT
 
+    /// \brief Fraction of the queued scene entities which have been loaded,
+    /// from 0 to 1. It's 1 when nothing is waiting to be loaded.
+    Q_PROPERTY(
+      double loadProgress
+      READ LoadProgress
+      NOTIFY LoadProgressChanged
+    )
+
+    /// \brief Summary of the scene synchronization statistics of the last
+    /// reporting period, one line per value.
+    Q_PROPERTY(
+      QString stats
+      READ Stats
+      NOTIFY StatsChanged
+    )
+
     /// \brief Constructor
     public: TransportSceneManager();
 
@@ -52,9 +240,27 @@ namespace gz::gui::plugins
   // Documentation inherited
   public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
 
+    /// \brief Get the scene load progress
+    /// \return Fraction of queued entities loaded, from 0 to 1
+    public: Q_INVOKABLE double LoadProgress() const;
+
+    /// \brief Notify that the scene load progress has changed
+    signals: void LoadProgressChanged();
+
+    /// \brief Get the summary of the last statistics report
+    /// \return One line per counter and histogram
+    public: Q_INVOKABLE QString Stats() const;
+
+    /// \brief Notify that a statistics report was made
+    signals: void StatsChanged();
+
     // Documentation inherited
     private: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
+    /// \brief Set the scene load progress, notifying if it changed
+    /// \param[in] _progress Fraction of queued entities loaded, from 0 to 1
+    private: void SetLoadProgress(double _progress);
+
     /// \internal
     /// \brief Pointer to private data.
     GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
@@ -42,6 +42,37 @@ GridLayout {
           "<br><b>Scene topic</b>: /" + sceneTopic
   }
 
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    visible: _TransportSceneManager.loadProgress < 1.0
+    text: "Loading scene: " +
+          Math.floor(_TransportSceneManager.loadProgress * 100) + "%"
+  }
+
+  ProgressBar {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    visible: _TransportSceneManager.loadProgress < 1.0
+    from: 0
+    to: 1
+    value: _TransportSceneManager.loadProgress
+  }
+
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    text: "<b>Statistics</b>"
+  }
+
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    textFormat: Text.PlainText
+    font.family: "monospace"
+    text: _TransportSceneManager.stats
+  }
+
 
   Item {
     Layout.columnSpan: 1
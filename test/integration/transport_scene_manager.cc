@@ -16,13 +16,25 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+
 #include <QtTest/QtTest>
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/scene.pb.h>
 #include <gz/msgs/uint32_v.pb.h>
+#include <gz/msgs/Utility.hh>
 #include <gz/rendering/Camera.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
@@ -263,3 +275,806 @@ TEST(TransportSceneManagerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Config))
   scene.reset();
   win->QuickWindow()->close();
 }
+
+/////////////////////////////////////////////////
+TEST(TransportSceneManagerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(EarlyPose))
+{
+  bool sceneRequested{false};
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &) -> bool
+  {
+    sceneRequested = true;
+    return true;
+  };
+
+  // Scene service
+  transport::Node node;
+  node.Advertise<msgs::Scene>("/early/scene", sceneService);
+
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugins
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>banana</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/early/scene</service>"
+      "<pose_topic>/early/pose</pose_topic>"
+      "<deletion_topic>/early/delete</deletion_topic>"
+      "<scene_topic>/early/scene_update</scene_topic>"
+    "</plugin>";
+
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (!sceneRequested && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+  EXPECT_TRUE(sceneRequested);
+
+  auto scene = engine->SceneByName("banana");
+  ASSERT_NE(nullptr, scene);
+  auto root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // Publish a pose for a model which doesn't exist yet, giving discovery
+  // some time first
+  auto posePub = node.Advertise<msgs::Pose_V>("/early/pose");
+  for (sleep = 0; sleep < 5; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  }
+  msgs::Pose_V poseVMsg;
+  auto poseMsg = poseVMsg.add_pose();
+  poseMsg->set_id(10);
+  poseMsg->mutable_position()->set_x(5);
+  posePub.Publish(poseVMsg);
+
+  for (sleep = 0; sleep < 5; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  }
+
+  // Now spawn the model, the pose received earlier is applied right away
+  auto scenePub = node.Advertise<msgs::Scene>("/early/scene_update");
+  msgs::Scene sceneMsg;
+  auto modelMsg = sceneMsg.add_model();
+  modelMsg->set_id(10);
+  modelMsg->set_name("early_model");
+  scenePub.Publish(sceneMsg);
+
+  for (sleep = 0; !scene->HasVisualName("early_model") && sleep < maxSleep;
+      ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  }
+  auto modelVis = scene->VisualByName("early_model");
+  ASSERT_NE(nullptr, modelVis);
+  EXPECT_EQ(math::Pose3d(5, 0, 0, 0, 0, 0), modelVis->LocalPose());
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+  {
+    auto pluginName = p->CardItem()->objectName().toStdString();
+    EXPECT_TRUE(app.RemovePlugin(pluginName));
+  }
+  plugins.clear();
+
+  scene.reset();
+  win->QuickWindow()->close();
+}
+
+/////////////////////////////////////////////////
+TEST(TransportSceneManagerTest,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LazyCollapse))
+{
+  std::atomic<bool> sceneRequested{false};
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &_rep) -> bool
+  {
+    auto modelMsg = _rep.add_model();
+    modelMsg->set_id(60);
+    modelMsg->set_name("lazy_model");
+
+    auto linkMsg = modelMsg->add_link();
+    linkMsg->set_id(61);
+    linkMsg->set_name("lazy_link");
+
+    auto visMsg = linkMsg->add_visual();
+    visMsg->set_id(62);
+    visMsg->set_name("lazy_vis");
+    msgs::Set(visMsg->mutable_geometry()->mutable_box()->mutable_size(),
+        math::Vector3d::One);
+
+    sceneRequested = true;
+    return true;
+  };
+
+  // Scene service
+  transport::Node node;
+  node.Advertise<msgs::Scene>("/lazy/scene", sceneService);
+
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugins
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>banana</scene>"
+      "<camera_pose>1 2 3 0 0 0</camera_pose>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/lazy/scene</service>"
+      "<pose_topic>/lazy/pose</pose_topic>"
+      "<deletion_topic>/lazy/delete</deletion_topic>"
+      "<scene_topic>/lazy/scene_update</scene_topic>"
+      "<lazy_load_distance>10</lazy_load_distance>"
+    "</plugin>";
+
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+
+  const int maxSleep = 30;
+  auto waitFor = [&](const std::function<bool()> &_condition)
+  {
+    for (int sleep = 0; !_condition() && sleep < maxSleep; ++sleep)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      QCoreApplication::processEvents();
+    }
+    return _condition();
+  };
+  EXPECT_TRUE(waitFor([&]{ return sceneRequested.load(); }));
+
+  auto scene = engine->SceneByName("banana");
+  ASSERT_NE(nullptr, scene);
+
+  // The camera starts close enough for the model to be built
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("lazy_link"); }));
+  auto camera = std::dynamic_pointer_cast<rendering::Camera>(
+      scene->RootVisual()->ChildByIndex(0));
+  ASSERT_NE(nullptr, camera);
+
+  // Move the link once, publishers only send poses which change
+  auto posePub = node.Advertise<msgs::Pose_V>("/lazy/pose");
+  EXPECT_TRUE(waitFor([&]{ return posePub.HasConnections(); }));
+
+  const math::Pose3d linkPose(0, 1, 0, 0, 0, 0.5);
+  msgs::Pose_V poseVMsg;
+  auto poseMsg = poseVMsg.add_pose();
+  poseMsg->set_id(61);
+  msgs::Set(poseMsg, linkPose);
+  posePub.Publish(poseVMsg);
+  EXPECT_TRUE(waitFor([&]
+  {
+    return scene->VisualByName("lazy_link")->LocalPose() == linkPose;
+  }));
+
+  // Move away, the link is released
+  camera->SetWorldPosition(1000, 0, 0);
+  EXPECT_TRUE(waitFor([&]{ return !scene->HasVisualName("lazy_link"); }));
+
+  // Come back, the link is rebuilt where it was
+  camera->SetWorldPosition(1, 2, 3);
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("lazy_link"); }));
+  EXPECT_TRUE(waitFor([&]
+  {
+    return scene->VisualByName("lazy_link")->LocalPose() == linkPose;
+  }));
+  camera.reset();
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+  {
+    auto pluginName = p->CardItem()->objectName().toStdString();
+    EXPECT_TRUE(app.RemovePlugin(pluginName));
+  }
+  plugins.clear();
+
+  scene.reset();
+  win->QuickWindow()->close();
+}
+
+/////////////////////////////////////////////////
+TEST(TransportSceneManagerTest,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(DeltaUpdates))
+{
+  std::atomic<int> sceneRequests{0};
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &_rep) -> bool
+  {
+    // The second request is the resync after a gap
+    if (++sceneRequests > 1)
+    {
+      auto data = _rep.mutable_header()->add_data();
+      data->set_key("seq");
+      data->add_value("5");
+
+      auto modelMsg = _rep.add_model();
+      modelMsg->set_id(21);
+      modelMsg->set_name("delta_b");
+
+      modelMsg = _rep.add_model();
+      modelMsg->set_id(30);
+      modelMsg->set_name("resync_model");
+    }
+    return true;
+  };
+
+  // Scene service
+  transport::Node node;
+  node.Advertise<msgs::Scene>("/delta/scene", sceneService);
+
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugins
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>banana</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/delta/scene</service>"
+      "<pose_topic>/delta/pose</pose_topic>"
+      "<deletion_topic>/delta/delete</deletion_topic>"
+      "<scene_topic>/delta/scene_update</scene_topic>"
+    "</plugin>";
+
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+
+  const int maxSleep = 30;
+  auto waitFor = [&](const std::function<bool()> &_condition)
+  {
+    for (int sleep = 0; !_condition() && sleep < maxSleep; ++sleep)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      QCoreApplication::processEvents();
+    }
+    return _condition();
+  };
+  EXPECT_TRUE(waitFor([&]{ return sceneRequests > 0; }));
+
+  auto scene = engine->SceneByName("banana");
+  ASSERT_NE(nullptr, scene);
+
+  auto scenePub = node.Advertise<msgs::Scene>("/delta/scene_update");
+  waitFor([&]{ return scenePub.HasConnections(); });
+
+  auto delta = [](std::uint64_t _seq)
+  {
+    msgs::Scene msg;
+    auto data = msg.mutable_header()->add_data();
+    data->set_key("seq");
+    data->add_value(std::to_string(_seq));
+    return msg;
+  };
+
+  // Add a model
+  auto msg = delta(1u);
+  auto modelMsg = msg.add_model();
+  modelMsg->set_id(20);
+  modelMsg->set_name("delta_a");
+  scenePub.Publish(msg);
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("delta_a"); }));
+
+  // Remove it and add another
+  msg = delta(2u);
+  auto data = msg.mutable_header()->add_data();
+  data->set_key("deleted");
+  data->add_value("20");
+  modelMsg = msg.add_model();
+  modelMsg->set_id(21);
+  modelMsg->set_name("delta_b");
+  scenePub.Publish(msg);
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("delta_b"); }));
+  EXPECT_FALSE(scene->HasVisualName("delta_a"));
+  EXPECT_EQ(1, sceneRequests);
+  auto deltaB = scene->VisualByName("delta_b");
+
+  // Skip seq 3, the full scene is requested and reconciled with the
+  // current one. The delta is already covered by the full scene's seq.
+  msg = delta(4u);
+  modelMsg = msg.add_model();
+  modelMsg->set_id(22);
+  modelMsg->set_name("delta_c");
+  scenePub.Publish(msg);
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("resync_model"); }));
+  EXPECT_EQ(2, sceneRequests);
+  EXPECT_FALSE(scene->HasVisualName("delta_c"));
+
+  // Models which didn't change are kept as they are
+  EXPECT_EQ(deltaB, scene->VisualByName("delta_b"));
+  deltaB.reset();
+
+  // Deltas continue after the full scene's seq
+  msg = delta(6u);
+  modelMsg = msg.add_model();
+  modelMsg->set_id(23);
+  modelMsg->set_name("delta_d");
+  scenePub.Publish(msg);
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("delta_d"); }));
+  EXPECT_EQ(2, sceneRequests);
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+  {
+    auto pluginName = p->CardItem()->objectName().toStdString();
+    EXPECT_TRUE(app.RemovePlugin(pluginName));
+  }
+  plugins.clear();
+
+  scene.reset();
+  win->QuickWindow()->close();
+}
+
+/////////////////////////////////////////////////
+TEST(TransportSceneManagerTest,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(DeltaBeforeScene))
+{
+  // The service only replies once the test published its deltas
+  std::atomic<int> sceneRequests{0};
+  std::mutex deltasMutex;
+  std::condition_variable deltasCv;
+  bool deltasSent{false};
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &_rep) -> bool
+  {
+    ++sceneRequests;
+    {
+      std::unique_lock<std::mutex> lock(deltasMutex);
+      deltasCv.wait_for(lock, std::chrono::seconds(5),
+          [&]{ return deltasSent; });
+    }
+
+    // Taken before the deltas were published
+    auto data = _rep.mutable_header()->add_data();
+    data->set_key("seq");
+    data->add_value("1");
+
+    auto modelMsg = _rep.add_model();
+    modelMsg->set_id(50);
+    modelMsg->set_name("snapshot_a");
+
+    modelMsg = _rep.add_model();
+    modelMsg->set_id(51);
+    modelMsg->set_name("snapshot_b");
+    return true;
+  };
+
+  // Scene service
+  transport::Node node;
+  node.Advertise<msgs::Scene>("/early_delta/scene", sceneService);
+
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugins
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>banana</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/early_delta/scene</service>"
+      "<pose_topic>/early_delta/pose</pose_topic>"
+      "<deletion_topic>/early_delta/delete</deletion_topic>"
+      "<scene_topic>/early_delta/scene_update</scene_topic>"
+    "</plugin>";
+
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+
+  const int maxSleep = 30;
+  auto waitFor = [&](const std::function<bool()> &_condition)
+  {
+    for (int sleep = 0; !_condition() && sleep < maxSleep; ++sleep)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      QCoreApplication::processEvents();
+    }
+    return _condition();
+  };
+  EXPECT_TRUE(waitFor([&]{ return sceneRequests > 0; }));
+
+  auto scene = engine->SceneByName("banana");
+  ASSERT_NE(nullptr, scene);
+
+  auto scenePub = node.Advertise<msgs::Scene>("/early_delta/scene_update");
+  EXPECT_TRUE(waitFor([&]{ return scenePub.HasConnections(); }));
+
+  auto delta = [](std::uint64_t _seq)
+  {
+    msgs::Scene msg;
+    auto data = msg.mutable_header()->add_data();
+    data->set_key("seq");
+    data->add_value(std::to_string(_seq));
+    return msg;
+  };
+
+  // Already part of the scene
+  auto msg = delta(1u);
+  auto modelMsg = msg.add_model();
+  modelMsg->set_id(52);
+  modelMsg->set_name("stale_delta");
+  scenePub.Publish(msg);
+
+  // Deletes a model of the scene, which is replied afterwards
+  msg = delta(2u);
+  auto data = msg.mutable_header()->add_data();
+  data->set_key("deleted");
+  data->add_value("51");
+  scenePub.Publish(msg);
+
+  {
+    std::lock_guard<std::mutex> lock(deltasMutex);
+    deltasSent = true;
+  }
+  deltasCv.notify_all();
+
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("snapshot_a"); }));
+
+  // Render a few more frames, the deleted model never comes back
+  for (int i = 0; i < 10; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_FALSE(scene->HasVisualName("snapshot_b"));
+  EXPECT_FALSE(scene->HasVisualName("stale_delta"));
+
+  // Deltas continue after the last one received before the scene
+  msg = delta(3u);
+  modelMsg = msg.add_model();
+  modelMsg->set_id(53);
+  modelMsg->set_name("after_scene");
+  scenePub.Publish(msg);
+  EXPECT_TRUE(waitFor([&]{ return scene->HasVisualName("after_scene"); }));
+  EXPECT_EQ(1, sceneRequests);
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+  {
+    auto pluginName = p->CardItem()->objectName().toStdString();
+    EXPECT_TRUE(app.RemovePlugin(pluginName));
+  }
+  plugins.clear();
+
+  scene.reset();
+  win->QuickWindow()->close();
+}
+
+/////////////////////////////////////////////////
+TEST(TransportSceneManagerTest,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(TimeToFirstFrame))
+{
+  using Clock = std::chrono::steady_clock;
+  std::atomic<Clock::rep> requestTime{0};
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &_rep) -> bool
+  {
+    requestTime = Clock::now().time_since_epoch().count();
+    auto modelMsg = _rep.add_model();
+    modelMsg->set_id(40);
+    modelMsg->set_name("first_frame_model");
+    return true;
+  };
+
+  transport::Node node;
+
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugins
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>banana</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/fast/scene</service>"
+      "<pose_topic>/fast/pose</pose_topic>"
+      "<deletion_topic>/fast/delete</deletion_topic>"
+      "<scene_topic>/fast/scene_update</scene_topic>"
+    "</plugin>";
+
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  const auto start = Clock::now();
+  win->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+  auto scene = engine->SceneByName("banana");
+  ASSERT_NE(nullptr, scene);
+
+  // Let the plugin look for the scene service before it's advertised
+  while (Clock::now() - start < std::chrono::milliseconds(300))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_FALSE(scene->HasVisualName("first_frame_model"));
+
+  const auto advertised = Clock::now();
+  node.Advertise<msgs::Scene>("/fast/scene", sceneService);
+
+  // Render until the model from the scene service shows up, which takes a
+  // retry after the service appeared
+  const auto timeout = std::chrono::seconds(10);
+  while (!scene->HasVisualName("first_frame_model") &&
+      Clock::now() - advertised < timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    QCoreApplication::processEvents();
+  }
+  const auto firstFrame = Clock::now() - advertised;
+  ASSERT_TRUE(scene->HasVisualName("first_frame_model"));
+  ASSERT_NE(0, requestTime);
+
+  // Timings depend on the machine, so they're only logged
+  const auto toRequest =
+      Clock::time_point(Clock::duration(requestTime.load())) - advertised;
+  gzmsg << "Scene requested "
+        << std::chrono::duration<double, std::milli>(toRequest).count()
+        << " ms after the service was advertised, first frame after "
+        << std::chrono::duration<double, std::milli>(firstFrame).count()
+        << " ms" << std::endl;
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+  {
+    auto pluginName = p->CardItem()->objectName().toStdString();
+    EXPECT_TRUE(app.RemovePlugin(pluginName));
+  }
+  plugins.clear();
+
+  scene.reset();
+  win->QuickWindow()->close();
+}
+
+/////////////////////////////////////////////////
+TEST(TransportSceneManagerTest,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ManyMeshes))
+{
+  const std::string meshFile =
+      common::joinPaths(PROJECT_SOURCE_PATH, "test", "media", "box.obj");
+  const unsigned int modelCount{300u};
+
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &_rep) -> bool
+  {
+    for (unsigned int i = 0u; i < modelCount; ++i)
+    {
+      auto modelMsg = _rep.add_model();
+      modelMsg->set_id(1000u + i * 3u);
+      modelMsg->set_name("mesh_model_" + std::to_string(i));
+      msgs::Set(modelMsg->mutable_pose(),
+          math::Pose3d(i % 20, i / 20, 0, 0, 0, 0));
+
+      auto linkMsg = modelMsg->add_link();
+      linkMsg->set_id(1001u + i * 3u);
+      linkMsg->set_name("link");
+
+      auto visualMsg = linkMsg->add_visual();
+      visualMsg->set_id(1002u + i * 3u);
+      visualMsg->set_name("mesh_visual_" + std::to_string(i));
+      auto geometryMsg = visualMsg->mutable_geometry();
+      geometryMsg->set_type(msgs::Geometry::MESH);
+      geometryMsg->mutable_mesh()->set_filename(meshFile);
+    }
+    return true;
+  };
+
+  // Scene service
+  transport::Node node;
+  node.Advertise<msgs::Scene>("/meshes/scene", sceneService);
+
+  // Frame load times reported while the scene loads
+  std::mutex statsMutex;
+  int loadFrames{0};
+  double worstP90{0.0};
+  double worstMax{0.0};
+  std::function<void(const msgs::Param &)> onStats =
+      [&](const msgs::Param &_msg)
+  {
+    for (const auto &child : _msg.children())
+    {
+      const auto &params = child.params();
+      auto name = params.find("name");
+      if (name == params.end() ||
+          name->second.string_value() != "frame_load_time_ms" ||
+          params.at("count").int_value() == 0)
+      {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(statsMutex);
+      loadFrames += params.at("count").int_value();
+      worstP90 = std::max(worstP90, params.at("p90").double_value());
+      worstMax = std::max(worstMax, params.at("max").double_value());
+    }
+  };
+  node.Subscribe("/meshes/stats", onStats);
+
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugins
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>banana</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/meshes/scene</service>"
+      "<pose_topic>/meshes/pose</pose_topic>"
+      "<deletion_topic>/meshes/delete</deletion_topic>"
+      "<scene_topic>/meshes/scene_update</scene_topic>"
+      "<stats_topic>/meshes/stats</stats_topic>"
+      "<stats_period>0.2</stats_period>"
+      "<load_budget_ms>10</load_budget_ms>"
+    "</plugin>";
+
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+  auto scene = engine->SceneByName("banana");
+  ASSERT_NE(nullptr, scene);
+
+  // Render until the last model is loaded, then until its stats are out
+  const std::string lastVisual =
+      "mesh_visual_" + std::to_string(modelCount - 1u);
+  int sleep = 0;
+  const int maxSleep = 300;
+  while (!scene->HasVisualName(lastVisual) && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_TRUE(scene->HasVisualName(lastVisual));
+  for (int i = 0; i < 25; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    QCoreApplication::processEvents();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    gzmsg << "Loaded " << modelCount << " mesh models over " << loadFrames
+          << " frames, p90 frame load time " << worstP90 << " ms, max "
+          << worstMax << " ms" << std::endl;
+
+    // The scene is spread over frames. Frame times depend on the machine,
+    // so they're only logged.
+    EXPECT_GT(loadFrames, 1);
+  }
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+  {
+    auto pluginName = p->CardItem()->objectName().toStdString();
+    EXPECT_TRUE(app.RemovePlugin(pluginName));
+  }
+  plugins.clear();
+
+  scene.reset();
+  win->QuickWindow()->close();
+}
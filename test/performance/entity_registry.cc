@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "EntityRegistry.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Stand-in for a rendering node, so the benchmark measures the
+/// bookkeeping and not the render engine.
+struct BenchmarkNode
+{
+  /// \brief Last pose set
+  math::Pose3d pose;
+};
+
+/// \brief Number of entities in the scene
+static constexpr unsigned int kEntityCount{20000u};
+
+/// \brief Number of lights in the scene, placed after the visuals
+static constexpr unsigned int kLightCount{100u};
+
+/// \brief Number of simulated render frames
+static constexpr unsigned int kFrameCount{200u};
+
+/////////////////////////////////////////////////
+// Compare applying a full pose frame through the node-based maps that
+// TransportSceneManager used to keep with the dense entity registry.
+TEST(EntityRegistryPerformance, PoseApplication)
+{
+  std::vector<std::shared_ptr<BenchmarkNode>> nodes;
+  nodes.reserve(kEntityCount + kLightCount);
+  for (unsigned int i = 0u; i < kEntityCount + kLightCount; ++i)
+    nodes.push_back(std::make_shared<BenchmarkNode>());
+
+  // Previous layout: separate ordered maps for visuals and lights
+  std::map<unsigned int, std::weak_ptr<BenchmarkNode>> visuals;
+  std::map<unsigned int, std::weak_ptr<BenchmarkNode>> lights;
+  for (unsigned int i = 0u; i < kEntityCount; ++i)
+    visuals[i] = nodes[i];
+  for (unsigned int i = kEntityCount; i < kEntityCount + kLightCount; ++i)
+    lights[i] = nodes[i];
+
+  // New layout: dense registry
+  EntityRegistry<BenchmarkNode> registry;
+  for (unsigned int i = 0u; i < kEntityCount; ++i)
+    registry.Add(i, EntityType::kVisual, nodes[i]);
+  for (unsigned int i = kEntityCount; i < kEntityCount + kLightCount; ++i)
+    registry.Add(i, EntityType::kLight, nodes[i]);
+
+  std::size_t mapApplied{0u};
+  auto mapStart = std::chrono::steady_clock::now();
+  for (unsigned int frame = 0u; frame < kFrameCount; ++frame)
+  {
+    std::map<unsigned int, math::Pose3d> poses;
+    for (unsigned int i = 0u; i < kEntityCount + kLightCount; ++i)
+      poses[i] = math::Pose3d(frame, i, 0, 0, 0, 0);
+
+    for (const auto &[id, pose] : poses)
+    {
+      auto vIt = visuals.find(id);
+      if (vIt != visuals.end())
+      {
+        if (auto node = vIt->second.lock())
+        {
+          node->pose = pose;
+          ++mapApplied;
+        }
+        continue;
+      }
+      auto lIt = lights.find(id);
+      if (lIt != lights.end())
+      {
+        if (auto node = lIt->second.lock())
+        {
+          node->pose = pose;
+          ++mapApplied;
+        }
+      }
+    }
+  }
+  std::chrono::duration<double, std::milli> mapTime =
+      std::chrono::steady_clock::now() - mapStart;
+
+  std::size_t registryApplied{0u};
+  auto registryStart = std::chrono::steady_clock::now();
+  std::unordered_map<unsigned int, math::Pose3d> poses;
+  for (unsigned int frame = 0u; frame < kFrameCount; ++frame)
+  {
+    poses.clear();
+    for (unsigned int i = 0u; i < kEntityCount + kLightCount; ++i)
+      poses[i] = math::Pose3d(frame, i, 0, 0, 0, 0);
+
+    for (const auto &[id, pose] : poses)
+      registry.StagePose(id, pose);
+
+    registryApplied += registry.ApplyStagedPoses(
+        [](BenchmarkNode &_node,
+           const EntityRegistry<BenchmarkNode>::Slot &_slot)
+        {
+          _node.pose = _slot.pose;
+          return true;
+        });
+  }
+  std::chrono::duration<double, std::milli> registryTime =
+      std::chrono::steady_clock::now() - registryStart;
+
+  EXPECT_EQ(mapApplied, registryApplied);
+  EXPECT_EQ(static_cast<std::size_t>(kFrameCount) *
+      (kEntityCount + kLightCount), registryApplied);
+
+  std::cout << "Applying " << kEntityCount + kLightCount << " poses over "
+            << kFrameCount << " frames:" << std::endl
+            << "  std::map:       " << mapTime.count() / kFrameCount
+            << " ms/frame" << std::endl
+            << "  EntityRegistry: " << registryTime.count() / kFrameCount
+            << " ms/frame" << std::endl;
+}